@@ -2,27 +2,16 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include "memory_pool.h"
+#include "generic.h"
 
 #define TYPE_INT "TYPE_INT"
 #define TYPE_DOUBLE "TYPE_DOUBLE"
 
-typedef struct linked_list_node LinkedListNode;
-struct linked_list_node {
-    double value;
-    LinkedListNode *next;
-};
-typedef struct linked_list {
-    LinkedListNode *head;
-} LinkedList;
+GENERATE_LINKED_LIST(LinkedList, linked_list, double, GENERIC_COMPARE, "%f ")
 
 int array_print(const void *array, const size_t length, const char *type) ;
 int bucketsort_modified(double *array, const size_t length) ;
-LinkedList *linked_list_create() ;
-LinkedList *linked_list_destroy(LinkedList *list) ;
-void linked_list_add(LinkedList *list, double value) ;
-void bubblesort(double *array, size_t length) ;
-size_t linked_list_get_length(const LinkedList *list) ;
-void linked_list_as_array(const LinkedList *list, double *array) ;
 
 int main() {
     srand((unsigned) time(NULL));
@@ -72,22 +61,19 @@ int bucketsort_modified(double *array, const size_t length) {
     size_t biggest_bucket = 0;
     for (size_t bucket_index = 0; bucket_index < length; ++bucket_index) {
 
-        // Get bucket as array and sort it
+        // Sort the bucket in place
         LinkedList *current_bucket = buckets[bucket_index];
         size_t bucket_size = linked_list_get_length(current_bucket);
-        double bucket_as_array[bucket_size];
-        linked_list_as_array(current_bucket, bucket_as_array);
-        bubblesort(bucket_as_array, bucket_size);
+        linked_list_sort(current_bucket);
 
         // Update biggest bucket
         biggest_bucket = (biggest_bucket < bucket_size) ? bucket_size : biggest_bucket;
 
         // Append the sorted bucket to the array
-        for (size_t value_index = 0; value_index < bucket_size; value_index++) {
-            array[array_index + value_index] = bucket_as_array[value_index];
+        for (LinkedListNode *node = current_bucket->head; node; node = node->next) {
+            array[array_index++] = node->value;
         }
 
-        array_index += bucket_size;
         linked_list_destroy(current_bucket);
     }
 
@@ -97,119 +83,6 @@ int bucketsort_modified(double *array, const size_t length) {
 
 // UTILITY
 
-LinkedListNode *linked_list_node_create(const double value) {
-    LinkedListNode *result = malloc(sizeof(LinkedListNode));
-    if (result == NULL) {
-        perror("Could not allocate memory!");
-        return NULL;
-    }
-
-    result->value = value;
-    result->next = NULL;
-
-    return result;
-}
-
-LinkedListNode *linked_list_node_destroy_recursively(LinkedListNode *node) {
-    if (node) {
-        node->next = linked_list_node_destroy_recursively(node->next);
-    }
-    free(node);
-    return NULL;
-}
-
-LinkedList *linked_list_create() {
-    return calloc(1, sizeof(LinkedList));
-}
-
-LinkedList *linked_list_destroy(LinkedList *list) {
-    if (list) {
-        list->head = linked_list_node_destroy_recursively(list->head);
-    }
-    free(list);
-    return NULL;
-}
-
-size_t linked_list_get_length(const LinkedList *list) {
-    size_t result = 0;
-
-    if (list) {
-        LinkedListNode *head = list->head;
-
-        while (head != NULL) {
-            head = head->next;
-            ++result;
-        }
-    }
-
-    return result;
-}
-
-int linked_list_insert(LinkedList *list, const double value, const size_t index) {
-
-    // Catch index out of range
-    if (index > linked_list_get_length(list)) {
-        perror("List index out of range!");
-        return 2;
-    }
-
-    LinkedListNode *head = list->head;
-    LinkedListNode *to_insert = linked_list_node_create(value);
-    if (to_insert == NULL) {
-        return 1;
-    }
-
-    // Catch append to front case
-    // Else insert normally
-    if (index == 0) {
-        to_insert->next = head;
-        list->head = to_insert;
-    } else {
-        LinkedListNode *before = head;
-
-        for (size_t i = 0; i < index; ++i) {
-            before = head;
-            head = head->next;
-        }
-
-        before->next = to_insert;
-        to_insert->next = head;
-    }
-    return 0;
-}
-
-void linked_list_as_array(const LinkedList *list, double *array) {
-
-    LinkedListNode *node = list->head;
-
-    for (size_t i = 0; i < linked_list_get_length(list); ++i) {
-        array[i] = node->value;
-        node = node->next;
-    }
-}
-
-void linked_list_add(LinkedList *list, const double value) {
-    linked_list_insert(list, value, linked_list_get_length(list));
-}
-
-void swap(double *array, const size_t a, const size_t b) {
-    double temp = array[a];
-    array[a] = array[b];
-    array[b] = temp;
-}
-
-void bubblesort(double *array, const size_t length) {
-    if (!length) return;
-
-    for (size_t end_index = length - 1; end_index > 0; --end_index) {
-        for (size_t start_index = 0; start_index < end_index; ++start_index) {
-            if (array[start_index] > array[end_index]) {
-                swap(array, start_index, end_index);
-            }
-        }
-    }
-}
-
 void print_double(const void *number) {
     double result = *((double*)number);
     printf("%f ", result);
@@ -4,6 +4,7 @@
 #include <math.h>
 #include <stdbool.h>
 #include <time.h>
+#include "memory_pool.h"
 
 #define STRING_SIZE 5
 
@@ -15,9 +16,10 @@ struct node {
 };
 typedef struct tree {
     TreeNode *root;
+    MemoryPool *pool;
 } Tree;
 
-Tree *tree_create() ;
+Tree *tree_create(MemoryPool *pool) ;
 void tree_add(Tree *tree, const int value) ;
 void tree_optimize(Tree *tree) ;
 Tree *tree_destroy(Tree *tree) ;
@@ -32,7 +34,7 @@ int main() {
 }
 
 void test_compression(const size_t numbers) {
-    Tree *tree = tree_create();
+    Tree *tree = tree_create(memory_pool_create(sizeof(TreeNode), numbers));
 
     // Add random values between 0 and 9999 to the tree
     srand((unsigned) time(NULL));
@@ -86,7 +88,7 @@ int tree_search(const Tree *tree, const int value) {
     return tree_search_internal(tree->root, value, value);
 }
 
-void tree_node_optimize(TreeNode *node) {
+void tree_node_optimize(TreeNode *node, MemoryPool *pool) {
     if (node == NULL) {
         return;
     }
@@ -125,16 +127,20 @@ void tree_node_optimize(TreeNode *node) {
                 }
 
                 // free child (not its children!)
-                free(child);
+                if (pool) {
+                    memory_pool_free(pool, child);
+                } else {
+                    free(child);
+                }
 
                 // call optimize on myself
-                tree_node_optimize(node);
+                tree_node_optimize(node, pool);
                 return;
             }
         }
     } else {
         for (int i = 0; i < 10; ++i) {
-            tree_node_optimize(node->children[i]);
+            tree_node_optimize(node->children[i], pool);
         }
     }
 }
@@ -181,14 +187,14 @@ void tree_optimize(Tree *tree) {
     } else {
         // node is already optimal, call optimize on all children
         for (int i = 0; i < 10; ++i) {
-            tree_node_optimize(node->children[i]);
+            tree_node_optimize(node->children[i], tree->pool);
         }
     }
 }
 
-TreeNode *tree_node_create(const int suffix, const size_t suffix_length) {
+TreeNode *tree_node_create(MemoryPool *pool, const int suffix, const size_t suffix_length) {
 
-    TreeNode *result = malloc(sizeof(TreeNode));
+    TreeNode *result = pool ? memory_pool_allocate(pool) : malloc(sizeof(TreeNode));
     if (result == NULL) {
         return NULL;
     }
@@ -203,53 +209,83 @@ TreeNode *tree_node_create(const int suffix, const size_t suffix_length) {
     return result;
 }
 
+// Destroys a node and all of its descendants without recursion. Descending into a child leaves the way back in the
+// emptied child slot, so the first occupied slot of a node that is returned to holds its parent. The topmost node
+// points to itself instead, since NULL would look like an empty slot
 TreeNode *tree_node_destroy(TreeNode *node) {
-    if (node) {
-        for (int i = 0; i < 10; ++i) {
-            node->children[i] = tree_node_destroy(node->children[i]);
+    TreeNode *parent = NULL;
+    while (node) {
+        size_t i = 0;
+        while (i < 10 && node->children[i] == NULL) {
+            ++i;
+        }
+
+        if (i < 10) {
+            TreeNode *child = node->children[i];
+            node->children[i] = parent ? parent : node;
+            parent = node;
+            node = child;
+        } else {
+            free(node);
+            node = parent;
+            if (node) {
+                i = 0;
+                while (node->children[i] == NULL) {
+                    ++i;
+                }
+                parent = (node->children[i] == node) ? NULL : node->children[i];
+                node->children[i] = NULL;
+            }
         }
     }
-    free(node);
     return NULL;
 }
 
-Tree *tree_create() {
+// The tree takes ownership of the pool, which may be NULL to allocate every node using malloc
+Tree *tree_create(MemoryPool *pool) {
     Tree *result = malloc(sizeof(Tree));
     if (result == NULL) {
         return NULL;
     }
-    result->root = tree_node_create(0, 0);
+    result->pool = pool;
+    result->root = tree_node_create(pool, 0, 0);
     return result;
 }
 
+// A pooled tree is released together with its pool in one step
 Tree *tree_destroy(Tree *tree) {
     if (tree) {
-        tree->root = tree_node_destroy(tree->root);
+        if (tree->pool) {
+            tree->pool = memory_pool_destroy(tree->pool);
+            tree->root = NULL;
+        } else {
+            tree->root = tree_node_destroy(tree->root);
+        }
     }
     free(tree);
     return NULL;
 }
 
-void tree_add_internal(TreeNode *node, const int value, const size_t depth) {
+void tree_add_internal(TreeNode *node, const int value, const size_t depth, MemoryPool *pool) {
 
     // Get the last digit of the value, according to its depth
     int last_digit = value / (int) pow(10, depth) % 10;
 
     if (node->children[last_digit] == NULL) {
         if (depth < STRING_SIZE - 1) {
-            node->children[last_digit] = tree_node_create(last_digit, 1);
-            tree_add_internal(node->children[last_digit], value, depth + 1);
+            node->children[last_digit] = tree_node_create(pool, last_digit, 1);
+            tree_add_internal(node->children[last_digit], value, depth + 1, pool);
         } else {
-            node->children[last_digit] = tree_node_create(value, STRING_SIZE);
+            node->children[last_digit] = tree_node_create(pool, value, STRING_SIZE);
         }
     } else {
-        tree_add_internal(node->children[last_digit], value, depth + 1);
+        tree_add_internal(node->children[last_digit], value, depth + 1, pool);
     }
 }
 
 // will add to the tree only if the value is not already in the tree
 void tree_add(Tree *tree, const int value) {
     if (tree_search(tree, value) == 0) {
-        tree_add_internal(tree->root, value, 0);
+        tree_add_internal(tree->root, value, 0, tree->pool);
     }
 }
@@ -1,17 +1,13 @@
 #include <time.h>
 #include <stdlib.h>
 #include <stdio.h>
+#include "memory_pool.h"
+#include "generic.h"
 
 #define TABLE_SIZE 128
 
-typedef struct linked_list_node LinkedListNode;
-struct linked_list_node {
-    int value;
-    LinkedListNode *next;
-};
-typedef struct linked_list {
-    LinkedListNode *head;
-} LinkedList;
+GENERATE_LINKED_LIST(LinkedList, linked_list, int, GENERIC_COMPARE, "%d ")
+
 typedef size_t (*hash_function)(const int *);
 typedef struct hash_table {
     LinkedList *rows[TABLE_SIZE];
@@ -23,7 +19,6 @@ size_t hash_modulo(const int *parameters) ;
 size_t hash_universal(const int *parameters) ;
 HashTable *hash_table_destroy(HashTable *hash_table) ;
 void hash_table_add(HashTable *hash_table, const int *parameters) ;
-size_t linked_list_get_length(LinkedList *list) ;
 HashTable *hash_table_create(const hash_function hash_function, const size_t argument_count) ;
 size_t get_max_chain_length(int input[TABLE_SIZE], const hash_function hash_function, int *hash_parameters) ;
 
@@ -121,10 +116,6 @@ size_t hash_universal(const int *parameters) {
     return ((parameters[1] * (size_t) parameters[0] + parameters[2]) % 491) % TABLE_SIZE;
 }
 
-LinkedList *linked_list_create() {
-    return calloc(1, sizeof(LinkedList));
-}
-
 HashTable *hash_table_create(const hash_function hash_function, const size_t argument_count) {
     HashTable *result = malloc(sizeof(HashTable));
 
@@ -141,84 +132,6 @@ HashTable *hash_table_create(const hash_function hash_function, const size_t arg
     return result;
 }
 
-LinkedListNode *linked_list_node_create(int value) {
-    LinkedListNode *result = malloc(sizeof(LinkedListNode));
-    if (result == NULL) {
-        perror("Could not allocate memory!");
-        return NULL;
-    }
-
-    result->value = value;
-    result->next = NULL;
-
-    return result;
-}
-
-LinkedListNode *linked_list_node_destroy_recursively(LinkedListNode *node) {
-    if (node) {
-        node->next = linked_list_node_destroy_recursively(node->next);
-    }
-    free(node);
-    return NULL;
-}
-
-LinkedList *linked_list_destroy(LinkedList *list) {
-    if (list) {
-        list->head = linked_list_node_destroy_recursively(list->head);
-    }
-    free(list);
-    return NULL;
-}
-
-size_t linked_list_get_length(LinkedList *list) {
-    LinkedListNode *head = list->head;
-    size_t result = 0;
-
-    while (head != NULL) {
-        head = head->next;
-        ++result;
-    }
-
-    return result;
-}
-
-int linked_list_insert(LinkedList *list, int value, size_t index) {
-
-    // Catch index out of range
-    if (index > linked_list_get_length(list)) {
-        perror("List index out of range!");
-        return 2;
-    }
-
-    LinkedListNode *head = list->head;
-    LinkedListNode *to_insert = linked_list_node_create(value);
-    if (to_insert == NULL) {
-        return 1;
-    }
-
-    // Catch append to front case
-    // Else insert normally
-    if (index == 0) {
-        to_insert->next = head;
-        list->head = to_insert;
-    } else {
-        LinkedListNode *before = head;
-
-        for (size_t i = 0; i < index; ++i) {
-            before = head;
-            head = head->next;
-        }
-
-        before->next = to_insert;
-        to_insert->next = head;
-    }
-    return 0;
-}
-
-void linked_list_add(LinkedList *list, int value) {
-    linked_list_insert(list, value, linked_list_get_length(list));
-}
-
 HashTable *hash_table_destroy(HashTable *hash_table) {
     if (hash_table) {
         for (size_t i = 0; i < TABLE_SIZE; ++i) {
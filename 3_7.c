@@ -3,6 +3,7 @@
 #include <assert.h>
 #include <time.h>
 #include <stdbool.h>
+#include "simd.h"
 
 void priority_queue_insert(int *queue, const int value, size_t *size) ;
 int priority_queue_remove_max(int *queue, size_t *size) ;
@@ -81,42 +82,40 @@ int priority_queue_remove_max(int *queue, size_t *size) {
     return max;
 }
 
-/// Verifies that the heap property is fulfilled for a given heap
+/// Verifies that the heap property is fulfilled for a given heap. Checking every element against its parent covers all
+/// paths, which the vectorized kernel does several elements at a time
 int heap_verify(const int *heap, const size_t size) {
-    for (size_t i = size / 2; i < size; ++i) {
-        size_t index = i;
-        size_t parent_index = (size_t) ceil(index / 2.0) - 1;
-        while (index > 0) {
-            if (heap[index] > heap[parent_index]) {
-                return false;
-            }
-            index = parent_index;
-            parent_index = (size_t) ceil(index / 2.0) - 1;
-        }
-    }
-    return true;
+    return simd_is_max_heap(heap, size);
 }
 
 /// Checks the heap property for an element at given index, compares it with its two child nodes. If one of its children
-/// is bigger, it will swap them and call this function again on the child index.
+/// is bigger, it will swap them and continue at the child index.
 /// \param array The heap to check as an array
 /// \param index The index to start checking at
 /// \param heap_size The size of the heap
 void heap_max_heapify(int *array, const size_t index, const size_t heap_size) {
-    size_t left_child_index = 2 * index + 1;
-    size_t right_child_index = 2 * index + 2;
+    if (index >= heap_size) {
+        return;
+    }
 
-    size_t maximum = ((left_child_index < heap_size) && (array[left_child_index] > array[index]))
-                     ? left_child_index : index;
+    int value = array[index];
+    size_t hole = index;
 
-    if ((right_child_index < heap_size) && (array[right_child_index] > array[maximum])) {
-        maximum = right_child_index;
-    }
-    if (maximum != index) {
-        swap(array, index, maximum);
-        heap_max_heapify(array, maximum, heap_size);
+    // Instead of swapping on every level, move the larger child up into the hole and write the value once at the end
+    while (2 * hole + 1 < heap_size) {
+        size_t maximum = 2 * hole + 1;
+        if (maximum + 1 < heap_size && array[maximum + 1] > array[maximum]) {
+            ++maximum;
+        }
+        if (array[maximum] <= value) {
+            break;
+        }
+
+        array[hole] = array[maximum];
+        hole = maximum;
     }
 
+    array[hole] = value;
 }
 
 /// Constructs a binary heap out of an arbitrary array.
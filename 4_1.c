@@ -14,7 +14,13 @@ int main() {
     printf("Created a config files with %d operations\n", config_status);
 
     printf("Generating a tree of degree %d: \n", DEGREE);
-    BTree *tree = b_tree_create();
+    struct memory_pool *pool = memory_pool_create(sizeof(BTreeNode), DEGREE * 8);
+    BTree *tree = pool ? b_tree_create_pooled(pool) : NULL;
+    if (tree == NULL) {
+        memory_pool_destroy(pool);
+        printf("Error: Tree could not be created!\n");
+        return 1;
+    }
 
     int status = parse_config(tree);
     if (status) {
@@ -7,7 +7,6 @@
 
 typedef struct b_tree_node BTreeNode;
 typedef enum {NODE, LEAF} node_type;
-typedef enum {int_type, node_pointer_type} data_type;
 struct b_tree_node {
     node_type type_of_node;
     size_t children_count;
@@ -17,16 +16,10 @@ struct b_tree_node {
     BTreeNode *children[DEGREE + 1];
     BTreeNode *parent;
 };
+/// If pool is set, all nodes are allocated from it
 typedef struct b_tree {
     BTreeNode *root;
+    struct memory_pool *pool;
 } BTree;
-typedef struct linked_list_node LinkedListNode;
-struct linked_list_node {
-    BTreeNode * value;
-    LinkedListNode *next;
-};
-typedef struct linked_list {
-    LinkedListNode *head;
-} LinkedList;
 
 #endif //DATA_STRUCTURES_4_1_H
@@ -7,7 +7,7 @@
 #include <time.h>
 
 BTreeNode *b_tree_search_internal(const BTreeNode *node, const int value) {
-    if (array_contains(node->keys, node->keys_count, &value, int_type)) {
+    if (int_array_contains(node->keys, node->keys_count, value)) {
         return NULL;
     } else if (node->type_of_node == LEAF) {
         // if we are at a leaf, return. we can not go down further!
@@ -25,7 +25,7 @@ BTreeNode *b_tree_search_internal(const BTreeNode *node, const int value) {
 }
 
 BTreeNode *b_tree_find_key_internal(const BTreeNode *node, const int value) {
-    if (array_contains(node->keys, node->keys_count, &value, int_type)) {
+    if (int_array_contains(node->keys, node->keys_count, value)) {
         return (BTreeNode *) node;
     } else if (node->type_of_node == LEAF) {
         // if we are at a leaf, return. we can not go down further!
@@ -73,14 +73,14 @@ void b_tree_insert(BTreeNode *node, const int value, BTree *tree) {
         int middle = temp[middle_index];
 
         // create left child
-        BTreeNode *first_child = b_tree_node_create();
+        BTreeNode *first_child = b_tree_node_create(tree);
         for (size_t i = 0; i < middle_index; ++i) {
             first_child->keys[i] = temp[i];
             first_child->keys_count++;
         }
 
         // create right child
-        BTreeNode *second_child = b_tree_node_create();
+        BTreeNode *second_child = b_tree_node_create(tree);
         for (size_t i = middle_index + 1; i < DEGREE; ++i) {
             second_child->keys[i - (middle_index + 1)] = temp[i];
             second_child->keys_count++;
@@ -104,8 +104,8 @@ void b_tree_insert(BTreeNode *node, const int value, BTree *tree) {
 
         // we only need to create a new root when the old node was the root
         if (node->parent == NULL) {
-            free(node);
-            node = b_tree_node_create();
+            b_tree_node_destroy(tree, node);
+            node = b_tree_node_create(tree);
             node->keys[0] = middle;
             node->keys_count++;
 
@@ -126,7 +126,7 @@ void b_tree_insert(BTreeNode *node, const int value, BTree *tree) {
             b_tree_link_child_insert(node->parent, second_child, (size_t) insertion_index + 1);
 
             b_tree_insert(node->parent, middle, tree);
-            free(node);
+            b_tree_node_destroy(tree, node);
         }
     }
 }
@@ -165,7 +165,7 @@ void handle_underflow(BTreeNode *node, BTree *tree) {
 
             // pass that value to parent
             // note that parent keys can overflow here, so we need to perform this on a temp array and update parent later
-            array_delete(compensator->keys, &compensator->keys_count, &to_insert, int_type);
+            int_array_delete(compensator->keys, &compensator->keys_count, to_insert);
             size_t temp_size = parent->keys_count + 1;
             int temp[temp_size];
             memcpy(temp, parent->keys, parent->keys_count * sizeof(int));
@@ -177,7 +177,7 @@ void handle_underflow(BTreeNode *node, BTree *tree) {
             b_tree_insert(node, temp[index_to_insert], tree);
 
             // update temp
-            array_delete(temp, &temp_size, &temp[index_to_insert], int_type);
+            int_array_delete(temp, &temp_size, temp[index_to_insert]);
 
             // now update the parent
             for (size_t i = 0; i < parent->keys_count; ++i) {
@@ -190,14 +190,12 @@ void handle_underflow(BTreeNode *node, BTree *tree) {
                     // take the leftmost child of sibling
                     BTreeNode *child = compensator->children[0];
                     b_tree_link_child_add(node, child);
-                    array_delete(compensator->children, &compensator->children_count,
-                                 child, node_pointer_type);
+                    node_array_delete(compensator->children, &compensator->children_count, child);
                 } else {
                     // take the rightmost one
                     BTreeNode *child = compensator->children[compensator->children_count - 1];
                     b_tree_link_child_insert(node, child, 0);
-                    array_delete(compensator->children, &compensator->children_count,
-                                 child, node_pointer_type);
+                    node_array_delete(compensator->children, &compensator->children_count, child);
                 }
             }
         } else {
@@ -235,11 +233,11 @@ void handle_underflow(BTreeNode *node, BTree *tree) {
             b_tree_insert(sibling, parent->keys[index], tree);
 
             // remove old node (which is empty anyways)
-            array_delete(parent->children, &parent->children_count, node, node_pointer_type);
-            free(node);
+            node_array_delete(parent->children, &parent->children_count, node);
+            b_tree_node_destroy(tree, node);
 
             // remove the moved key from parent
-            array_delete(parent->keys, &parent->keys_count, &parent->keys[index], int_type);
+            int_array_delete(parent->keys, &parent->keys_count, parent->keys[index]);
 
             // finally check if parent underflows now
             handle_underflow(parent, tree);
@@ -247,9 +245,9 @@ void handle_underflow(BTreeNode *node, BTree *tree) {
     } else if (node->keys_count == 0 && node->children_count == 1) {
         // This happens when the root node has an underflow and one child.
         // Note that we do not need to transfer any children because root can only underflow with 0 keys
-        free(tree->root);
         tree->root = node->children[0];
         node->children[0]->parent = NULL;
+        b_tree_node_destroy(tree, node);
     }
 }
 
@@ -257,20 +255,20 @@ void b_tree_remove_internal(BTreeNode *node, const int value, BTree *tree) {
 
     if (node->type_of_node == LEAF) {
         // Case 1: LEAF
-        array_delete(node->keys, &node->keys_count, &value, int_type);
+        int_array_delete(node->keys, &node->keys_count, value);
     } else {
         // Case 2: NODE
         // Internal node contains the value
         // replace value with the next largest value
         BTreeNode *node_with_next_largest_value = b_tree_find_next_largest_value(node, value);
-        ssize_t index_to_replace = array_get_index(node->keys, value);
+        size_t index_to_replace = int_array_get_index(node->keys, node->keys_count, value);
         int next_largest_value = node_with_next_largest_value->keys[0];
         node->keys[index_to_replace] = next_largest_value;
 
         // note that we do not actually perform the swap here but instead just delete the next largest which would be
         // replaced by the target value anyways
-        array_delete(node_with_next_largest_value->keys, &node_with_next_largest_value->keys_count,
-                     &next_largest_value, int_type);
+        int_array_delete(node_with_next_largest_value->keys, &node_with_next_largest_value->keys_count,
+                         next_largest_value);
         node = node_with_next_largest_value;
     }
 
@@ -283,7 +281,7 @@ void b_tree_remove(BTree *tree, const int value) {
         BTreeNode *node = b_tree_find_key(tree, value);
 
         // remove if the value is inside
-        if (node && array_contains(node->keys, node->keys_count, &value, int_type)) {
+        if (node && int_array_contains(node->keys, node->keys_count, value)) {
             b_tree_remove_internal(node, value, tree);
         }
     }
@@ -302,7 +300,7 @@ int b_tree_add(BTree *tree, const int value) {
         }
     } else {
         // if root is null, add a new one with value as first key
-        tree->root = b_tree_node_create();
+        tree->root = b_tree_node_create(tree);
         tree->root->keys[0] = value;
         tree->root->keys_count++;
     }
@@ -1,115 +1,36 @@
 #include "4_1_helper.h"
+#include "memory_pool.h"
 #include <stdio.h>
 #include <stdbool.h>
 #include <limits.h>
 #include <memory.h>
 #include <assert.h>
 
-LinkedListNode *linked_list_node_create(BTreeNode *value) {
-    LinkedListNode *result = malloc(sizeof(LinkedListNode));
-    if (result == NULL) {
-        perror("Could not allocate memory!");
-        return NULL;
-    }
-
-    result->value = value;
-    result->next = NULL;
-
-    return result;
-}
-
-LinkedListNode *linked_list_node_destroy_recursively(LinkedListNode *node) {
-    if (node) {
-        node->next = linked_list_node_destroy_recursively(node->next);
-    }
-    free(node);
-    return NULL;
-}
-
-LinkedList *linked_list_create() {
-    return calloc(1, sizeof(LinkedList));
-}
-
-LinkedList *linked_list_destroy(LinkedList *list) {
-    if (list) {
-        list->head = linked_list_node_destroy_recursively(list->head);
-    }
-    free(list);
-    return NULL;
-}
-
-size_t linked_list_get_length(const LinkedList *list) {
-    LinkedListNode *head = list->head;
-    size_t result = 0;
-
-    while (head != NULL) {
-        head = head->next;
-        ++result;
-    }
+GENERATE_COMPARATOR(compare_ints, int, GENERIC_COMPARE)
 
-    return result;
-}
-
-int linked_list_insert(LinkedList *list, BTreeNode * value, const size_t index) {
+GENERATE_ARRAY_FUNCTIONS(int_array, int, GENERIC_COMPARE)
 
-    // Catch index out of range
-    if (index > linked_list_get_length(list)) {
-        perror("List index out of range!");
-        return 2;
-    }
-
-    LinkedListNode *head = list->head;
-    LinkedListNode *to_insert = linked_list_node_create(value);
-    if (to_insert == NULL) {
-        return 1;
-    }
-
-    // Catch append to front case
-    // Else insert normally
-    if (index == 0) {
-        to_insert->next = head;
-        list->head = to_insert;
-    } else {
-        LinkedListNode *before = head;
-
-        for (size_t i = 0; i < index; ++i) {
-            before = head;
-            head = head->next;
-        }
-
-        before->next = to_insert;
-        to_insert->next = head;
-    }
-    return 0;
-}
-
-void linked_list_as_array(const LinkedList *list, BTreeNode *array[DEGREE + 1]) {
-
-    LinkedListNode *node = list->head;
-
-    for (size_t i = 0; i < linked_list_get_length(list); ++i) {
-        array[i] = node->value;
-        node = node->next;
-    }
-}
-
-void linked_list_add(LinkedList *list, BTreeNode * value) {
-    linked_list_insert(list, value, linked_list_get_length(list));
-}
-
-int compare_ints(const void *first, const void *second) {
-    int a = *(int*) first;
-    int b = *(int*) second;
-    return a < b ? -1 : a > b;
-}
+GENERATE_ARRAY_FUNCTIONS(node_array, BTreeNode *, GENERIC_COMPARE)
 
 BTreeNode *b_tree_node_destroy_recursively(BTreeNode *node) {
-    if (node) {
-        for (size_t i = 0; i < node->children_count; ++i) {
-            b_tree_node_destroy_recursively(node->children[i]);
+
+    // Descend into the last child, leaving the way back in the slot it occupied. Once a node has no children left it
+    // is freed and the walk continues at the parent stored in the parent's own vacated slot
+    BTreeNode *parent = NULL;
+    while (node) {
+        if (node->children_count) {
+            BTreeNode *child = node->children[--node->children_count];
+            node->children[node->children_count] = parent;
+            parent = node;
+            node = child;
+        } else {
+            free(node);
+            node = parent;
+            if (node) {
+                parent = node->children[node->children_count];
+            }
         }
     }
-    free(node);
     return NULL;
 }
 
@@ -121,15 +42,29 @@ BTree *b_tree_create() {
     }
 
     result->root = NULL;
+    result->pool = NULL;
     return result;
 }
 
-/// Destroys the tree, recursively destroying its nodes
+BTree *b_tree_create_pooled(struct memory_pool *pool) {
+    BTree *result = b_tree_create();
+    if (result) {
+        result->pool = pool;
+    }
+    return result;
+}
+
+/// Destroys the tree, recursively destroying its nodes. A pooled tree is released together with its pool in one step
 /// \param tree The tree to destroy
 /// \return A NULL pointer to clean up the tree pointer
 BTree *b_tree_destroy(BTree *tree) {
     if (tree) {
-        tree->root = b_tree_node_destroy_recursively(tree->root);
+        if (tree->pool) {
+            tree->pool = memory_pool_destroy(tree->pool);
+            tree->root = NULL;
+        } else {
+            tree->root = b_tree_node_destroy_recursively(tree->root);
+        }
     }
     free(tree);
     return NULL;
@@ -145,8 +80,8 @@ int string_to_integer(const char *string, int *integer) {
     return 1;
 }
 
-BTreeNode *b_tree_node_create() {
-    BTreeNode *result = malloc(sizeof(BTreeNode));
+BTreeNode *b_tree_node_create(BTree *tree) {
+    BTreeNode *result = tree->pool ? memory_pool_allocate(tree->pool) : malloc(sizeof(BTreeNode));
     if (result == NULL) {
         return NULL;
     }
@@ -158,98 +93,20 @@ BTreeNode *b_tree_node_create() {
     return result;
 }
 
-ssize_t array_get_index(const int *array, const int value) {
-    for (size_t i = 0; i < DEGREE; ++i) {
-        if (array[i] == value) {
-            return i;
-        }
-    }
-    return -1;
-}
-
-// note that this updates the size
-void array_insert(BTreeNode **array, size_t *array_size, const size_t index, BTreeNode *to_insert) {
-    LinkedList *list = linked_list_create();
-    for (size_t i = 0; i < *array_size; ++i) {
-        linked_list_add(list, array[i]);
-    }
-    linked_list_insert(list, to_insert, index);
-    linked_list_as_array(list, array);
-    ++*array_size;
-    linked_list_destroy(list);
-}
-
-// note that this updates the size
-// assumes this fits
-void array_add(BTreeNode *array[DEGREE + 1], size_t *array_size, BTreeNode *to_insert) {
-    LinkedList *list = linked_list_create();
-    for (size_t i = 0; i < *array_size; ++i) {
-        linked_list_add(list, array[i]);
+BTreeNode *b_tree_node_destroy(BTree *tree, BTreeNode *node) {
+    if (tree->pool) {
+        memory_pool_free(tree->pool, node);
+    } else {
+        free(node);
     }
-    linked_list_add(list, to_insert);
-    linked_list_as_array(list, array);
-    ++*array_size;
-    linked_list_destroy(list);
+    return NULL;
 }
 
 // note that this updates the size
 // ATTENTION: This assumes the array can actually fit an additional value
 void array_int_add_sorted(int *array, size_t *array_size, const int to_insert) {
     assert(*array_size < DEGREE - 1);
-    array[*array_size] = to_insert;
-    ++*array_size;
-    qsort(array, *array_size, sizeof(int), compare_ints);
-}
-
-int array_contains(const void *array, const size_t size, const void *value, const data_type type) {
-    if (type == int_type) {
-        int *cast_array = (int *) array;
-        int cast_value = *((int*) value);
-        for (size_t i = 0; i < size; ++i) {
-            if (cast_array[i] == cast_value) {
-                return true;
-            }
-        }
-    }
-    return false;
-}
-
-// assumes that all values are unique in the array
-// note that this updates the size
-// this simulates a dynamic data structure
-void array_delete(void *array, size_t *size, const void *value, const data_type type) {
-
-    if (type == int_type) {
-        int *cast_array = (int *) array;
-        int cast_value = *((int*) value);
-        int replace = false;
-
-        for (size_t i = 0; i < *size; ++i) {
-            if (cast_array[i] == cast_value) {
-                replace = true;
-                --*size;
-            }
-
-            if (replace) {
-                cast_array[i] = cast_array[i + 1];
-            }
-        }
-    } else if (type == node_pointer_type) {
-        BTreeNode **cast_array = (BTreeNode **) array;
-        BTreeNode *cast_value = (BTreeNode*) value;
-        int replace = false;
-
-        for (size_t i = 0; i < *size; ++i) {
-            if (cast_array[i] == cast_value) {
-                replace = true;
-                --*size;
-            }
-
-            if (replace) {
-                cast_array[i] = cast_array[i + 1];
-            }
-        }
-    }
+    int_array_add_sorted(array, array_size, to_insert);
 }
 
 /// Prints tree_node keys, also showing how many of the key slots are still unset
@@ -318,14 +175,14 @@ ssize_t b_tree_node_get_index(const BTreeNode **node_array, const size_t size, c
 /// Inserts a new child at a specific position into parent's children
 void b_tree_link_child_insert(BTreeNode *parent, BTreeNode *child, const size_t index) {
     child->parent = parent;
-    array_insert(parent->children, &parent->children_count, index, child);
+    node_array_insert(parent->children, &parent->children_count, index, child);
     parent->type_of_node = NODE;
 }
 
 /// Links two nodes, appending the child to the parent's list
 void b_tree_link_child_add(BTreeNode *parent, BTreeNode *child) {
     child->parent = parent;
-    array_add(parent->children, &parent->children_count, child);
+    node_array_add(parent->children, &parent->children_count, child);
     parent->type_of_node = NODE;
 }
 
@@ -339,7 +196,7 @@ void b_tree_overwrite_child(BTreeNode *parent, BTreeNode *child, const size_t in
 BTreeNode *b_tree_find_next_largest_value(BTreeNode *node, const int value) {
 
     // go right subtree of this key (every key has one, index will be key index + 1)
-    BTreeNode *current = node->children[array_get_index(node->keys, value) + 1];
+    BTreeNode *current = node->children[int_array_get_index(node->keys, node->keys_count, value) + 1];
 
     // then go very left as long as there are nodes and return
     while (current->type_of_node != LEAF) {
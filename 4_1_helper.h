@@ -2,12 +2,26 @@
 #define DATA_STRUCTURES_4_1_HELPER_H
 
 #include "4_1.h"
+#include "generic.h"
 #include <unistd.h>
 
+GENERATE_ARRAY_DECLARATIONS(int_array, int)
+GENERATE_ARRAY_DECLARATIONS(node_array, BTreeNode *)
+
 int compare_ints(const void *first, const void *second);
 
+/// The pool functions are defined in 4_1_helper.c, which includes memory_pool.h
+struct memory_pool *memory_pool_create(size_t element_size, size_t elements_per_block);
+struct memory_pool *memory_pool_destroy(struct memory_pool *pool);
+
 BTree *b_tree_create();
 
+/// Creates a tree which allocates its nodes from a pool. The tree takes ownership of the pool and releases it in
+/// b_tree_destroy, so the pool must not be shared with other structures. If NULL is returned, the caller keeps it
+/// \param pool A pool with an element size of at least sizeof(BTreeNode)
+/// \return A pointer to the new tree or NULL in case of memory error
+BTree *b_tree_create_pooled(struct memory_pool *pool);
+
 /// Destroys the tree, recursively destroying its nodes
 /// \param tree The tree to destroy
 /// \return A NULL pointer to clean up the tree pointer
@@ -15,28 +29,17 @@ BTree *b_tree_destroy(BTree *tree);
 
 int string_to_integer(const char *string, int *integer);
 
-BTreeNode *b_tree_node_create();
-
-ssize_t array_get_index(const int *array, const int value);
-
-// note that this updates the size
-void array_insert(BTreeNode **array, size_t *array_size, const size_t index, BTreeNode *to_insert);
+/// Creates a new leaf, using the tree's pool if it has one
+BTreeNode *b_tree_node_create(BTree *tree);
 
-// note that this updates the size
-// assumes this fits
-void array_add(BTreeNode *array[DEGREE + 1], size_t *array_size, BTreeNode *to_insert);
+/// Frees a single node, giving it back to the tree's pool if it has one
+/// \return A NULL pointer to clean up the node pointer
+BTreeNode *b_tree_node_destroy(BTree *tree, BTreeNode *node);
 
 // note that this updates the size
 // ATTENTION: This assumes the array can actually fit an additional value
 void array_int_add_sorted(int *array, size_t *array_size, const int to_insert);
 
-int array_contains(const void *array, const size_t size, const void *value, const data_type type);
-
-// assumes that all values are unique in the array
-// note that this updates the size
-// this simulates a dynamic data structure
-void array_delete(void *array, size_t *size, const void *value, const data_type type);
-
 /// Prints all the nodes of a tree recursively, indenting them for better readability
 /// \param tree The tree to print
 void b_tree_print(const BTree *tree);
@@ -3,263 +3,173 @@
 #include <stdio.h>
 #include <memory.h>
 #include <stdbool.h>
+#include "memory_pool.h"
+#include "generic.h"
+#include "csr_graph.h"
 
 
-typedef struct linked_list_node LinkedListNode;
+GENERATE_LINKED_LIST(LinkedList, linked_list, int, GENERIC_COMPARE, "%d ")
+
+/// The amount of slots the value index starts with
+#define ADJACENCY_LIST_INDEX_CAPACITY 16
+
 typedef struct adjacency_list_node AdjacencyListNode;
+
+/// The nodes form a doubly linked list. index is an open addressing hash table with linear probing mapping every value
+/// to its node, empty slots are NULL. Its capacity is a power of two and it is kept at most half full
 typedef struct adjacency_list {
     AdjacencyListNode *head;
+    AdjacencyListNode *tail;
+    size_t length;
+    AdjacencyListNode **index;
+    size_t capacity;
 } AdjacencyList;
-typedef struct linked_list {
-    LinkedListNode *head;
-} LinkedList;
-struct linked_list_node {
-    int value;
-    LinkedListNode *next;
-};
+/// in_degree is the amount of predecessors and kept up to date by linking and removing nodes. The out-degree is the
+/// length of successors
 struct adjacency_list_node {
     int value;
-    size_t order;
+    size_t in_degree;
     LinkedList *successors;
+    AdjacencyListNode *previous;
     AdjacencyListNode *next;
 };
 
 
 
-LinkedListNode *linked_list_node_create(int value) {
-    LinkedListNode *result = malloc(sizeof(LinkedListNode));
+AdjacencyListNode *adjacency_list_node_create(int value) {
+    AdjacencyListNode *result = malloc(sizeof(AdjacencyListNode));
     if (result == NULL) {
         perror("Could not allocate memory!");
         return NULL;
     }
 
     result->value = value;
+    result->in_degree = 0;
+    result->successors = linked_list_create();
+    result->previous = NULL;
     result->next = NULL;
 
     return result;
 }
 
-LinkedListNode *linked_list_node_destroy_recursively(LinkedListNode *node) {
+/// Destroys a node and all nodes following it. Iterates, so long lists can't overflow the stack
+AdjacencyListNode *adjacency_list_node_destroy_recursively(AdjacencyListNode *node) {
+    while (node) {
+        AdjacencyListNode *next = node->next;
+        node->successors = linked_list_destroy(node->successors);
+        free(node);
+        node = next;
+    }
+    return NULL;
+}
+
+AdjacencyListNode *adjacency_list_node_destroy(AdjacencyListNode *node) {
     if (node) {
-        node->next = linked_list_node_destroy_recursively(node->next);
+        node->successors = linked_list_destroy(node->successors);
     }
     free(node);
     return NULL;
 }
 
-LinkedList *linked_list_create() {
-    return calloc(1, sizeof(LinkedList));
+AdjacencyList *adjacency_list_create() {
+    return calloc(1, sizeof(AdjacencyList));
 }
 
-LinkedList *linked_list_destroy(LinkedList *list) {
+AdjacencyList *adjacency_list_destroy(AdjacencyList *list) {
     if (list) {
-        list->head = linked_list_node_destroy_recursively(list->head);
+        list->head = adjacency_list_node_destroy_recursively(list->head);
+        free(list->index);
     }
     free(list);
     return NULL;
 }
 
-size_t linked_list_get_length(LinkedList *list) {
-    size_t result = 0;
-    if (list) {
-        LinkedListNode *head = list->head;
-
-        while (head != NULL) {
-            head = head->next;
-            ++result;
-        }
-    }
-
-    return result;
-}
-
-int linked_list_insert(LinkedList *list, int value, size_t index) {
-
-    // Catch index out of range
-    if (index > linked_list_get_length(list)) {
-        perror("List index out of range!");
-        return 2;
-    }
-
-    LinkedListNode *head = list->head;
-    LinkedListNode *to_insert = linked_list_node_create(value);
-    if (to_insert == NULL) {
-        return 1;
-    }
-
-    // Catch append to front case
-    // Else insert normally
-    if (index == 0) {
-        to_insert->next = head;
-        list->head = to_insert;
-    } else {
-        LinkedListNode *before = head;
-
-        for (size_t i = 0; i < index; ++i) {
-            before = head;
-            head = head->next;
-        }
-
-        before->next = to_insert;
-        to_insert->next = head;
-    }
-    return 0;
-}
-
-int linked_list_add_sorted(LinkedList *list, int value) {
-
-    LinkedListNode *to_insert = linked_list_node_create(value);
-    if (to_insert == NULL) {
-        return 1;
-    }
-
-    LinkedListNode *current_node = list->head;
-
-    // Catch empty list and append to front case
-    if (current_node == NULL || current_node->value > value) {
-        to_insert->next = current_node;
-        list->head = to_insert;
-    } else {
-        LinkedListNode *precursor = NULL;
-
-        for (size_t i = 0; i < linked_list_get_length(list); ++i) {
-
-            precursor = current_node;
-            current_node = current_node->next;
-
-            // current node is NULL? Then we are at the end and the value to insert is the largest in the list
-            // or is the current value larger than our value? then we can insert too
-            if (current_node == NULL || current_node->value > value) {
-                to_insert->next = current_node;
-                precursor->next = to_insert;
-                break;
-            }
-            // if not, move further in the list
-        }
-    }
-    return 0;
+size_t adjacency_list_get_length(const AdjacencyList *list) {
+    return list->length;
 }
 
-void linked_list_as_array(LinkedList *list, int *array) {
-
-    LinkedListNode *node = list->head;
+/// Returns the slot where the probe sequence for a value starts
+/// \param value The value
+/// \param capacity The amount of slots, a power of two
+size_t adjacency_list_index_home(int value, size_t capacity) {
 
-    for (size_t i = 0; i < linked_list_get_length(list); ++i) {
-        array[i] = node->value;
-        node = node->next;
-    }
+    // Multiplicative hashing spreads consecutive values, the most common node values, over the whole index
+    uint64_t hash = (uint32_t) value * UINT64_C(0x9E3779B97F4A7C15);
+    return (size_t) (hash ^ (hash >> 32)) & (capacity - 1);
 }
 
-void linked_list_add(LinkedList *list, int value) {
-    if (list->head) {
-        linked_list_insert(list, value, linked_list_get_length(list));
-    } else {
-        list->head = linked_list_node_create(value);
+/// Returns the slot holding the node with a value or, if there is none, the empty slot where it belongs
+/// \param index The slots, at least one of them empty
+/// \param capacity The amount of slots, a power of two
+/// \param value The value to look for
+/// \return The position of the slot
+size_t adjacency_list_index_slot(AdjacencyListNode *const *index, size_t capacity, int value) {
+    size_t slot = adjacency_list_index_home(value, capacity);
+    while (index[slot] && index[slot]->value != value) {
+        slot = (slot + 1) & (capacity - 1);
     }
+    return slot;
 }
 
-void linked_list_print(LinkedList *list) {
-    if (list) {
-        LinkedListNode *head = list->head;
-
-        while (head != NULL) {
-            printf("%d ", head->value);
-            head = head->next;
+/// Enters a node into the value index, doubling the index first if it would become more than half full
+/// \param list The list
+/// \param node The node, its value must not be in the index yet
+/// \return 0 on success, 1 in case of memory error
+int adjacency_list_index_add(AdjacencyList *list, AdjacencyListNode *node) {
+    if (2 * (list->length + 1) > list->capacity) {
+        size_t capacity = list->capacity ? 2 * list->capacity : ADJACENCY_LIST_INDEX_CAPACITY;
+        AdjacencyListNode **index = calloc(capacity, sizeof(AdjacencyListNode *));
+        if (index == NULL) {
+            perror("Could not allocate memory!");
+            return 1;
         }
 
-        printf("\n");
-    }
-}
-
-int linked_list_contains(LinkedList *list, int value) {
-    if (list) {
-        LinkedListNode *current = list->head;
-        while (current) {
-            if (current->value == value) {
-                return 1;
+        for (size_t i = 0; i < list->capacity; ++i) {
+            if (list->index[i]) {
+                index[adjacency_list_index_slot(index, capacity, list->index[i]->value)] = list->index[i];
             }
-            current = current->next;
         }
+        free(list->index);
+        list->index = index;
+        list->capacity = capacity;
     }
-    return 0;
-}
 
-void linked_list_remove(LinkedList *list, int value) {
-    LinkedListNode *current = list->head;
-    LinkedListNode *last = NULL;
-    while (current) {
-        if (current->value == value) {
-            if (last == NULL) {
-                list->head = current->next;
-            } else if (current->next == NULL) {
-                last->next = NULL;
-            } else {
-                last->next = current->next;
-            }
-            free(current);
-            return;
-        }
-        last = current;
-        current = current->next;
-    }
+    list->index[adjacency_list_index_slot(list->index, list->capacity, node->value)] = node;
+    return 0;
 }
 
-
-AdjacencyListNode *adjacency_list_node_create(int value) {
-    AdjacencyListNode *result = malloc(sizeof(AdjacencyListNode));
-    if (result == NULL) {
-        perror("Could not allocate memory!");
-        return NULL;
+/// Removes a value from the value index. Later entries of the probe sequence are shifted back into the gap, so
+/// lookups never have to skip over deleted entries
+/// \param list The list
+/// \param value The value to remove
+void adjacency_list_index_remove(AdjacencyList *list, int value) {
+    if (list->capacity == 0) {
+        return;
     }
 
-    result->value = value;
-    result->successors = linked_list_create();
-    result->next = NULL;
-
-    return result;
-}
-
-AdjacencyListNode *adjacency_list_node_destroy_recursively(AdjacencyListNode *node) {
-    if (node) {
-        node->next = adjacency_list_node_destroy_recursively(node->next);
-        node->successors = linked_list_destroy(node->successors);
+    size_t mask = list->capacity - 1;
+    size_t gap = adjacency_list_index_slot(list->index, list->capacity, value);
+    if (list->index[gap] == NULL) {
+        return;
     }
-    free(node);
-    return NULL;
-}
 
-AdjacencyListNode *adjacency_list_node_destroy(AdjacencyListNode *node) {
-    if (node) {
-        node->successors = linked_list_destroy(node->successors);
-    }
-    free(node);
-    return NULL;
-}
+    for (size_t slot = (gap + 1) & mask; list->index[slot]; slot = (slot + 1) & mask) {
 
-AdjacencyList *adjacency_list_create() {
-    return calloc(1, sizeof(AdjacencyList));
-}
-
-AdjacencyList *adjacency_list_destroy(AdjacencyList *list) {
-    if (list) {
-        list->head = adjacency_list_node_destroy_recursively(list->head);
+        // An entry may only move back if the gap is not before the slot its probe sequence starts at
+        size_t home = adjacency_list_index_home(list->index[slot]->value, list->capacity);
+        if (((slot - home) & mask) >= ((slot - gap) & mask)) {
+            list->index[gap] = list->index[slot];
+            gap = slot;
+        }
     }
-    free(list);
-    return NULL;
-}
-
-size_t adjacency_list_get_length(AdjacencyList *list) {
-    AdjacencyListNode *head = list->head;
-    size_t result = 0;
-
-    while (head != NULL) {
-        head = head->next;
-        ++result;
-    }
-
-    return result;
+    list->index[gap] = NULL;
 }
 
+/// Inserts a new node at a position of the list
+/// \param list The list
+/// \param value The value of the new node
+/// \param index The position, at most the length of the list
+/// \return The new node or NULL in case of memory error, if the index is out of range or if value is already contained
 AdjacencyListNode *adjacency_list_insert(AdjacencyList *list, int value, size_t index) {
 
     // Catch index out of range
@@ -267,103 +177,119 @@ AdjacencyListNode *adjacency_list_insert(AdjacencyList *list, int value, size_t
         perror("List index out of range!");
         return NULL;
     }
+    if (list->capacity && list->index[adjacency_list_index_slot(list->index, list->capacity, value)]) {
+        return NULL;
+    }
 
-    AdjacencyListNode *head = list->head;
     AdjacencyListNode *to_insert = adjacency_list_node_create(value);
     if (to_insert == NULL) {
         return NULL;
     }
+    if (adjacency_list_index_add(list, to_insert)) {
+        return adjacency_list_node_destroy(to_insert);
+    }
 
-    // Catch append to front case
-    // Else insert normally
-    if (index == 0) {
-        to_insert->next = head;
-        list->head = to_insert;
-    } else {
-        AdjacencyListNode *before = head;
-
+    // Appending goes through the tail, anything else walks to the node currently at index
+    AdjacencyListNode *after = NULL;
+    if (index < list->length) {
+        after = list->head;
         for (size_t i = 0; i < index; ++i) {
-            before = head;
-            head = head->next;
+            after = after->next;
         }
+    }
 
-        before->next = to_insert;
-        to_insert->next = head;
+    to_insert->next = after;
+    to_insert->previous = after ? after->previous : list->tail;
+    if (to_insert->previous) {
+        to_insert->previous->next = to_insert;
+    } else {
+        list->head = to_insert;
+    }
+    if (after) {
+        after->previous = to_insert;
+    } else {
+        list->tail = to_insert;
     }
+
+    ++list->length;
     return to_insert;
 }
 
-int adjacency_list_contains_value(AdjacencyList *list, int value) {
-    if (list) {
-        AdjacencyListNode *current = list->head;
-        while (current) {
-            if (current->value == value) {
-                return true;
-            }
-            current = current->next;
-        }
-    }
-    return false;
+int adjacency_list_contains_value(const AdjacencyList *list, int value) {
+    return list && list->capacity && list->index[adjacency_list_index_slot(list->index, list->capacity, value)];
 }
 
+/// Appends a node with a value unless the list already contains one
+/// \return The node with the value or NULL in case of memory error
 AdjacencyListNode *adjacency_list_add(AdjacencyList *list, int value) {
-    if (list->head && !adjacency_list_contains_value(list, value)) {
-        return adjacency_list_insert(list, value, adjacency_list_get_length(list));
-    } else {
-        AdjacencyListNode *to_insert = adjacency_list_node_create(value);
-        list->head = to_insert;
-        return to_insert;
+    if (list->capacity) {
+        AdjacencyListNode *existing = list->index[adjacency_list_index_slot(list->index, list->capacity, value)];
+        if (existing) {
+            return existing;
+        }
     }
+    return adjacency_list_insert(list, value, list->length);
 }
 
 void adjacency_list_link_nodes(AdjacencyListNode *from, AdjacencyListNode *to) {
-    if (from && to && !linked_list_contains(from->successors, to->value)) {
-        linked_list_add(from->successors, to->value);
+    if (from && to && !linked_list_contains(from->successors, to->value)
+        && linked_list_insert(from->successors, to->value, from->successors->length) == 0) {
+        ++to->in_degree;
     }
 }
 
-AdjacencyListNode *adjacency_list_search(AdjacencyList *list, int value) {
-    if (list) {
-        AdjacencyListNode *current = list->head;
-        while (current) {
-            if (current->value == value) {
-                return current;
-            }
-            current = current->next;
-        }
+/// Finds the node with a value in expected O(1) through the value index
+/// \return The node or NULL if there is none
+AdjacencyListNode *adjacency_list_search(const AdjacencyList *list, int value) {
+    if (list == NULL || list->capacity == 0) {
+        return NULL;
     }
-    return NULL;
+    return list->index[adjacency_list_index_slot(list->index, list->capacity, value)];
 }
 
 void adjacency_list_link_nodes_by_value(AdjacencyList *list, int from_value, int to_value) {
-    AdjacencyListNode *from = adjacency_list_search(list, from_value);
-    AdjacencyListNode *to = adjacency_list_search(list, to_value);
-
-    if (from && to && !linked_list_contains(from->successors, to->value)) {
-        linked_list_add(from->successors, to->value);
-    }
+    adjacency_list_link_nodes(adjacency_list_search(list, from_value), adjacency_list_search(list, to_value));
 }
 
+/// Removes the node with a value together with all edges to and from it, updating the degrees of its neighbours.
+/// The node and its successors are found through the value index. Only the edges leading to the node need a scan of
+/// the other nodes, which is skipped for in-degree 0 and stops once all of them are gone
+/// \param list The list
+/// \param value The value of the node to remove
 void adjacency_list_remove(AdjacencyList *list, int value) {
-    AdjacencyListNode *current = list->head;
-    AdjacencyListNode *last = NULL;
-    while (current) {
-        if (current->value == value) {
-            if (last == NULL) {
-                list->head = current->next;
-            } else if (current->next == NULL) {
-                last->next = NULL;
-            } else {
-                last->next = current->next;
-            }
-            free(current);
-        } else {
-            linked_list_remove(current->successors, value);
+    AdjacencyListNode *removed = adjacency_list_search(list, value);
+    if (removed == NULL) {
+        return;
+    }
+
+    adjacency_list_index_remove(list, value);
+    if (removed->previous) {
+        removed->previous->next = removed->next;
+    } else {
+        list->head = removed->next;
+    }
+    if (removed->next) {
+        removed->next->previous = removed->previous;
+    } else {
+        list->tail = removed->previous;
+    }
+    --list->length;
+
+    for (LinkedListNode *successor = removed->successors->head; successor; successor = successor->next) {
+        AdjacencyListNode *node = adjacency_list_search(list, successor->value);
+        if (node) {
+            --node->in_degree;
         }
+    }
 
-        last = current;
-        current = current->next;
+    // A loop counts towards the in-degree but is gone with the node itself
+    size_t remaining = removed->in_degree - (linked_list_contains(removed->successors, value) ? 1 : 0);
+    for (AdjacencyListNode *current = list->head; current && remaining; current = current->next) {
+        if (linked_list_remove(current->successors, value) == 0) {
+            --remaining;
+        }
     }
+    adjacency_list_node_destroy(removed);
 }
 
 int adjacency_list_contains(AdjacencyList *list, AdjacencyListNode *node) {
@@ -385,6 +311,7 @@ AdjacencyList *adjacency_list_copy(const AdjacencyList *source) {
     AdjacencyListNode *current = source->head;
     while (current) {
         AdjacencyListNode *copied_node = adjacency_list_add(destination, current->value);
+        copied_node->in_degree = current->in_degree;
         LinkedListNode *current_successor = current->successors->head;
         while (current_successor) {
 
@@ -396,17 +323,109 @@ AdjacencyList *adjacency_list_copy(const AdjacencyList *source) {
     return destination;
 }
 
+/// Returns the amount of edges leading to the node with a value, without looking at the edges
+/// \param value The value of the node
+/// \param graph The graph
+/// \return The in-degree of the node or 0 if there is no node with that value
 size_t indeg(const int value, const AdjacencyList *graph) {
-    size_t result = 0;
+    AdjacencyListNode *node = adjacency_list_search(graph, value);
+    return node ? node->in_degree : 0;
+}
+
+/// Returns the amount of edges starting at the node with a value
+/// \param value The value of the node
+/// \param graph The graph
+/// \return The out-degree of the node or 0 if there is no node with that value
+size_t outdeg(const int value, const AdjacencyList *graph) {
+    AdjacencyListNode *node = adjacency_list_search(graph, value);
+    return node ? node->successors->length : 0;
+}
+
+/// Returns the in- or out-degree of a node
+size_t adjacency_list_node_degree(const AdjacencyListNode *node, int in) {
+    return in ? node->in_degree : node->successors->length;
+}
+
+/// Lists the nodes ordered by their in- or out-degree, highest first, in O(V + maximum degree) by counting sort.
+/// Nodes of equal degree keep their order
+/// \param list The list
+/// \param in 1 to order by in-degree, 0 to order by out-degree
+/// \param result Receives the nodes, must have room for all nodes of the list
+/// \return 0 on success, 1 in case of memory error
+int adjacency_list_by_degree(const AdjacencyList *list, int in, AdjacencyListNode **result) {
+    size_t maximum = 0;
+    for (AdjacencyListNode *current = list->head; current; current = current->next) {
+        size_t degree = adjacency_list_node_degree(current, in);
+        if (degree > maximum) {
+            maximum = degree;
+        }
+    }
 
-    AdjacencyListNode *current = graph->head;
-    while (current) {
-        if (linked_list_contains(current->successors, value)) {
-            ++result;
+    size_t *positions = calloc(maximum + 1, sizeof(size_t));
+    if (positions == NULL) {
+        perror("Could not allocate memory!");
+        return 1;
+    }
+
+    // Count the nodes per degree, then turn the counts into the first position of every degree, starting at the top
+    for (AdjacencyListNode *current = list->head; current; current = current->next) {
+        ++positions[adjacency_list_node_degree(current, in)];
+    }
+    size_t position = 0;
+    for (size_t degree = maximum + 1; degree-- > 0;) {
+        size_t count = positions[degree];
+        positions[degree] = position;
+        position += count;
+    }
+
+    for (AdjacencyListNode *current = list->head; current; current = current->next) {
+        result[positions[adjacency_list_node_degree(current, in)]++] = current;
+    }
+
+    free(positions);
+    return 0;
+}
+
+/// Converts the list into a CSR Graph for fast traversals. Node i of the graph is the i-th node of the list
+/// \param list The list to convert
+/// \return A pointer to the graph or NULL in case of memory error or if a successor is not a node of the list
+CsrGraph *adjacency_list_to_csr(const AdjacencyList *list) {
+    size_t edge_count = 0;
+    for (AdjacencyListNode *current = list->head; current; current = current->next) {
+        edge_count += current->successors->length;
+    }
+
+    CsrGraph *result = csr_graph_create(list->length, edge_count);
+    uint32_t *positions = malloc((list->capacity ? list->capacity : 1) * sizeof(uint32_t));
+    if (result == NULL || positions == NULL) {
+        free(positions);
+        return csr_graph_destroy(result);
+    }
+
+    // Successors are stored as values, positions maps the slot of every value in the index to the node number
+    size_t i = 0;
+    for (AdjacencyListNode *current = list->head; current; current = current->next, ++i) {
+        result->values[i] = current->value;
+        positions[adjacency_list_index_slot(list->index, list->capacity, current->value)] = (uint32_t) i;
+    }
+
+    size_t edge = 0;
+    i = 0;
+    for (AdjacencyListNode *current = list->head; current; current = current->next, ++i) {
+        result->offsets[i] = edge;
+
+        for (LinkedListNode *successor = current->successors->head; successor; successor = successor->next) {
+            size_t slot = adjacency_list_index_slot(list->index, list->capacity, successor->value);
+            if (list->index[slot] == NULL) {
+                free(positions);
+                return csr_graph_destroy(result);
+            }
+            result->targets[edge++] = positions[slot];
         }
-        current = current->next;
     }
+    result->offsets[list->length] = edge;
 
+    free(positions);
     return result;
 }
 
@@ -414,7 +433,7 @@ void adjacency_list_print(AdjacencyList *list) {
 
     AdjacencyListNode *current = list->head;
     while (current) {
-        printf("%d\t(%zu):\t", current->value, current->order);
+        printf("%d:\t", current->value);
         linked_list_print(current->successors);
         current = current->next;
     }
@@ -443,29 +462,46 @@ void link_random(AdjacencyList *list, int chance_not_to_link) {
     }
 }
 
-int topological_sort(AdjacencyList *graph) {
-    AdjacencyList *copy = adjacency_list_copy(graph);
-    size_t order = 1;
+/// Sorts the graph topologically with Kahn's algorithm in O(V + E) on its CSR form. The graph is not changed
+/// \param graph The graph to sort
+/// \param order Receives the node values so that every edge points to a later value, must have room for all nodes.
+/// Only complete if the graph is acyclic
+/// \param cycle Receives the values of the nodes of one cycle if the graph is cyclic, must have room for all nodes.
+/// May be NULL
+/// \param cycle_length Receives the length of the cycle, 0 for acyclic graphs. May be NULL if cycle is NULL
+/// \return 0 if the graph is acyclic, 1 in case of memory error and 2 if the graph contains a cycle
+int topological_sort(const AdjacencyList *graph, int *order, int *cycle, size_t *cycle_length) {
+    if (cycle_length) {
+        *cycle_length = 0;
+    }
 
-    // graph is cyclic if one full loop does not lead to a change
-    size_t changed = true;
-    while (copy->head && changed) {
-        changed = false;
-        AdjacencyListNode *current = copy->head;
-        while (current) {
-            // if indegree == 0, then assign a fresh number and remove
-            if (indeg(current->value, copy) == 0) {
-                adjacency_list_search(graph, current->value)->order = order++;
-                adjacency_list_remove(copy, current->value);
-                changed = true;
-            }
-            current = current->next;
-        }
+    CsrGraph *csr = adjacency_list_to_csr(graph);
+    if (csr == NULL) {
+        return 1;
+    }
+
+    // The first half receives the order, the second one the cycle
+    uint32_t *nodes = malloc((csr->node_count ? 2 * csr->node_count : 1) * sizeof(uint32_t));
+    if (nodes == NULL) {
+        perror("Could not allocate memory!");
+        csr_graph_destroy(csr);
+        return 1;
     }
 
-    adjacency_list_destroy(copy);
+    int result = csr_graph_topological_sort(csr, nodes, cycle ? nodes + csr->node_count : NULL, cycle_length);
+    if (result == 0) {
+        for (size_t i = 0; i < csr->node_count; ++i) {
+            order[i] = csr->values[nodes[i]];
+        }
+    } else if (result == 2 && cycle) {
+        for (size_t i = 0; i < *cycle_length; ++i) {
+            cycle[i] = csr->values[nodes[csr->node_count + i]];
+        }
+    }
 
-    return changed ? 0 : 1;
+    free(nodes);
+    csr_graph_destroy(csr);
+    return result;
 }
 
 void add_random(AdjacencyList *list, int limit) {
@@ -483,11 +519,32 @@ int main() {
 
     add_random(list, 15);
     link_random(list, 10);
-    int status = topological_sort(list);
 
-    printf("This graph is");
-    printf(status ? " cyclic\n" : " acyclic\n");
+    size_t length = adjacency_list_get_length(list);
+    int *values = malloc(length * sizeof(int));
+    if (values == NULL) {
+        perror("Could not allocate memory!");
+        adjacency_list_destroy(list);
+        return 1;
+    }
+
+    size_t cycle_length = 0;
+    int status = topological_sort(list, values, values, &cycle_length);
+
     adjacency_list_print(list);
+    if (status == 0) {
+        printf("This graph is acyclic, topological order:");
+    } else if (status == 2) {
+        printf("This graph is cyclic, cycle:");
+        length = cycle_length;
+    } else {
+        length = 0;
+    }
+    for (size_t i = 0; i < length; ++i) {
+        printf(" %d", values[i]);
+    }
+    printf("\n");
 
+    free(values);
     adjacency_list_destroy(list);
 }
\ No newline at end of file
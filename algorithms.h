@@ -81,32 +81,33 @@ void swap_d(double *array, size_t a, size_t b) {
 // ### ALGORITHMS ###
 
 /// Checks the heap property for an element at given index, compares it with its two child nodes. If one of its children
-/// is bigger, it will swap them and call this function again on the child index.
+/// is bigger, it will swap them and continue at the child index.
 /// \param array The heap to check as an array
 /// \param index The index to start checking at
 /// \param heap_size The size of the heap
 void heap_max_heapify(int *array, const size_t index, const size_t heap_size) {
-    size_t left_child_index = 2 * index + 1;
-    size_t right_child_index = 2 * index + 2;
-//    printf("\tIncoming: \n\t");
-//    print_array(array, heap_size, TYPE_INT);
+    if (index >= heap_size) {
+        return;
+    }
 
-//    printf("I am %d (%zu), my left child is %d (%zu) and my right child is %d (%zu)\n", array[index], index,
-//           array[left_child_index], left_child_index, array[right_child_index], right_child_index);
+    int value = array[index];
+    size_t hole = index;
 
-    size_t maximum = ((left_child_index < heap_size) && (array[left_child_index] > array[index]))
-                     ? left_child_index : index;
+    // Instead of swapping on every level, move the larger child up into the hole and write the value once at the end
+    while (2 * hole + 1 < heap_size) {
+        size_t maximum = 2 * hole + 1;
+        if (maximum + 1 < heap_size && array[maximum + 1] > array[maximum]) {
+            ++maximum;
+        }
+        if (array[maximum] <= value) {
+            break;
+        }
 
-    if ((right_child_index < heap_size) && (array[right_child_index] > array[maximum])) {
-        maximum = right_child_index;
-    }
-    if (maximum != index) {
-        swap(array, index, maximum);
-//        printf("\tAfter swapping: \n\t");
-//        print_array(array, heap_size, TYPE_INT);
-        heap_max_heapify(array, maximum, heap_size);
+        array[hole] = array[maximum];
+        hole = maximum;
     }
 
+    array[hole] = value;
 }
 
 /// Constructs a binary heap out of an arbitrary array.
@@ -235,19 +236,15 @@ int bucketsort(int *array, const size_t length) {
     size_t biggest_bucket = 0;
     for (size_t bucket_index = 0; bucket_index < length; ++bucket_index) {
 
-        // Get bucket as array and sort it
+        // Sort the bucket in place
         LinkedList *current_bucket = buckets[bucket_index];
-        size_t bucket_size = linked_list_get_length(current_bucket);
-        int bucket_as_array[bucket_size];
-        linked_list_as_array(current_bucket, bucket_as_array);
-        bubblesort(bucket_as_array, bucket_size);
+        linked_list_sort(current_bucket);
 
         // Append the sorted bucket to the array
-        for (size_t value_index = 0; value_index < bucket_size; value_index++) {
-            array[array_index + value_index] = bucket_as_array[value_index];
+        for (LinkedListNode *node = current_bucket->head; node; node = node->next) {
+            array[array_index++] = node->value;
         }
 
-        array_index += bucket_size;
         linked_list_destroy(current_bucket);
     }
     return 0;
@@ -0,0 +1,220 @@
+#include "data_structures.h"
+#include <time.h>
+#include <math.h>
+
+/*
+ * Compares the plain, the AVL and the splay mode of the Binary Tree.
+ * The first part inserts values in sorted, random and zipfian order. Sorted input and the duplicates of the zipfian
+ * order degenerate the plain tree into long chains, so these cases run on a smaller tree.
+ * The second part builds a tree of distinct values in random order and looks them up with zipfian skew, where a few
+ * hot values get most of the lookups.
+ * Build with optimizations, e.g. gcc -std=c99 -O2 benchmark_binary_tree.c -lm
+ */
+
+#define TREE_SIZE 1000000
+#define DEGENERATE_TREE_SIZE 20000
+#define SEARCHES 100000
+#define SKEWED_SEARCHES 2000000
+#define ZIPF_EXPONENT 1.0
+
+typedef enum {SORTED, RANDOM, ZIPFIAN, ORDER_COUNT} Order;
+
+const char *order_names[ORDER_COUNT] = {"sorted", "random", "zipfian"};
+const char *mode_names[] = {"plain", "AVL", "splay"};
+
+int *zipf_table_create(const size_t size, const double exponent) ;
+int zipf_sample(const int *table, const size_t size, uint64_t *state) ;
+void measure(BinaryTreeMode mode, const int *values, const size_t size, const int *to_search, const size_t searches,
+             double *insert_time, double *search_time, size_t *height) ;
+int benchmark_insertion_orders(uint64_t *state) ;
+int benchmark_skewed_lookups(uint64_t *state) ;
+
+int main() {
+    uint64_t state = (uint64_t) time(NULL);
+
+    if (benchmark_insertion_orders(&state) || benchmark_skewed_lookups(&state)) {
+        perror("Could not allocate memory!");
+        return 1;
+    }
+    return 0;
+}
+
+/// Inserts sorted, random and zipfian values into trees of every mode and searches some of them
+/// \param state The state of the random generator
+/// \return 0 if successful, else 1 in case of memory error
+int benchmark_insertion_orders(uint64_t *state) {
+    int *values = malloc(TREE_SIZE * sizeof(int));
+    int *to_search = malloc(SEARCHES * sizeof(int));
+    int *zipf_table = zipf_table_create(TREE_SIZE, ZIPF_EXPONENT);
+    if (values == NULL || to_search == NULL || zipf_table == NULL) {
+        free(values);
+        free(to_search);
+        free(zipf_table);
+        return 1;
+    }
+
+    printf("Inserting into and searching %d values in Binary Trees (seconds)\n\n", SEARCHES);
+    printf("%8s %8s %6s %12s %12s %8s\n", "Order", "Length", "Mode", "Insert", "Search", "Height");
+
+    for (Order order = 0; order < ORDER_COUNT; ++order) {
+        const size_t size = order == RANDOM ? TREE_SIZE : DEGENERATE_TREE_SIZE;
+
+        for (size_t i = 0; i < size; ++i) {
+            switch (order) {
+                case SORTED:
+                    values[i] = (int) i;
+                    break;
+                case RANDOM:
+                    values[i] = (int) (splitmix64_next(state) % TREE_SIZE);
+                    break;
+                default:
+                    values[i] = zipf_sample(zipf_table, TREE_SIZE, state);
+            }
+        }
+        for (size_t i = 0; i < SEARCHES; ++i) {
+            to_search[i] = values[splitmix64_next(state) % size];
+        }
+
+        for (BinaryTreeMode mode = BINARY_TREE_PLAIN; mode <= BINARY_TREE_SPLAY; ++mode) {
+            double insert_time, search_time;
+            size_t height;
+            measure(mode, values, size, to_search, SEARCHES, &insert_time, &search_time, &height);
+            printf("%8s %8zu %6s %12f %12f %8zu\n", order_names[order], size, mode_names[mode], insert_time,
+                   search_time, height);
+        }
+    }
+
+    free(values);
+    free(to_search);
+    free(zipf_table);
+    return 0;
+}
+
+/// Builds trees of every mode from distinct values in random order and measures zipfian lookups with several skews
+/// \param state The state of the random generator
+/// \return 0 if successful, else 1 in case of memory error
+int benchmark_skewed_lookups(uint64_t *state) {
+    const double exponents[] = {0.8, 1.0, 1.2};
+
+    int *values = malloc(TREE_SIZE * sizeof(int));
+    int *to_search = malloc(SKEWED_SEARCHES * sizeof(int));
+    if (values == NULL || to_search == NULL) {
+        free(values);
+        free(to_search);
+        return 1;
+    }
+
+    // A random permutation is both the insertion order and the mapping from popularity rank to value, so the hot
+    // values are spread over the whole tree
+    for (size_t i = 0; i < TREE_SIZE; ++i) {
+        values[i] = (int) i;
+    }
+    for (size_t i = TREE_SIZE - 1; i > 0; --i) {
+        size_t j = splitmix64_next(state) % (i + 1);
+        int temp = values[i];
+        values[i] = values[j];
+        values[j] = temp;
+    }
+
+    printf("\nSearching %d zipfian distributed values in Binary Trees of %d random values (seconds)\n\n",
+           SKEWED_SEARCHES, TREE_SIZE);
+    printf("%8s %6s %12s %12s %8s\n", "Exponent", "Mode", "Insert", "Search", "Height");
+
+    for (size_t i = 0; i < sizeof(exponents) / sizeof(exponents[0]); ++i) {
+        int *zipf_table = zipf_table_create(TREE_SIZE, exponents[i]);
+        if (zipf_table == NULL) {
+            free(values);
+            free(to_search);
+            return 1;
+        }
+        for (size_t j = 0; j < SKEWED_SEARCHES; ++j) {
+            to_search[j] = values[zipf_sample(zipf_table, TREE_SIZE, state)];
+        }
+        free(zipf_table);
+
+        for (BinaryTreeMode mode = BINARY_TREE_PLAIN; mode <= BINARY_TREE_SPLAY; ++mode) {
+            double insert_time, search_time;
+            size_t height;
+            measure(mode, values, TREE_SIZE, to_search, SKEWED_SEARCHES, &insert_time, &search_time, &height);
+            printf("%8.1f %6s %12f %12f %8zu\n", exponents[i], mode_names[mode], insert_time, search_time, height);
+        }
+    }
+
+    free(values);
+    free(to_search);
+    return 0;
+}
+
+/// Builds the cumulative distribution of a zipfian distribution over the ranks 0 to size - 1, scaled to 2^31
+/// \param size The amount of ranks
+/// \param exponent The skew of the distribution, 1 is the classic zipf law
+/// \return The table, or NULL in case of an allocation error
+int *zipf_table_create(const size_t size, const double exponent) {
+    double *weights = malloc(size * sizeof(double));
+    int *table = malloc(size * sizeof(int));
+    if (weights == NULL || table == NULL) {
+        free(weights);
+        free(table);
+        return NULL;
+    }
+
+    double total = 0;
+    for (size_t i = 0; i < size; ++i) {
+        weights[i] = 1.0 / pow((double) (i + 1), exponent);
+        total += weights[i];
+    }
+
+    double cumulative = 0;
+    for (size_t i = 0; i < size; ++i) {
+        cumulative += weights[i];
+        table[i] = (int) (cumulative / total * 2147483647.0);
+    }
+
+    free(weights);
+    return table;
+}
+
+/// Draws a rank from the zipfian distribution by searching a uniform number in the cumulative table
+/// \return The rank, small ranks are the most frequent ones
+int zipf_sample(const int *table, const size_t size, uint64_t *state) {
+    int uniform = (int) (splitmix64_next(state) >> 33);
+    size_t lower = 0;
+    size_t upper = size - 1;
+
+    while (lower < upper) {
+        size_t middle = lower + (upper - lower) / 2;
+        if (table[middle] < uniform) {
+            lower = middle + 1;
+        } else {
+            upper = middle;
+        }
+    }
+
+    return (int) lower;
+}
+
+/// Builds a tree in the given mode from values and measures the time of the insertions and of all searches
+void measure(BinaryTreeMode mode, const int *values, const size_t size, const int *to_search, const size_t searches,
+             double *insert_time, double *search_time, size_t *height) {
+    BinaryTree *tree = create_binary_tree_with_mode(mode, memory_pool_create(sizeof(BinaryTreeNode), 4096));
+    size_t found = 0;
+
+    clock_t start = clock();
+    for (size_t i = 0; i < size; ++i) {
+        add_to_binary_tree(tree, values[i]);
+    }
+    clock_t middle = clock();
+    for (size_t i = 0; i < searches; ++i) {
+        found += search_in_binary_tree(tree, to_search[i]) != NULL;
+    }
+    clock_t end = clock();
+
+    if (found != searches) {
+        printf("Lost values, found only %zu\n", found);
+    }
+
+    *insert_time = (double) (middle - start) / CLOCKS_PER_SEC;
+    *search_time = (double) (end - middle) / CLOCKS_PER_SEC;
+    *height = binary_tree_height(tree);
+    destroy_binary_tree(tree);
+}
@@ -0,0 +1,112 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include "data_structures.h"
+#include <time.h>
+
+/*
+ * Compares building an AVL Binary Tree from sorted values by inserting them one by one with the linear time bulk build,
+ * in the calling thread and with a growing number of threads, and the time of an in-order traversal afterwards.
+ * Build with e.g. gcc -std=c99 -O2 -pthread benchmark_binary_tree_from_sorted.c
+ */
+
+#define MAX_THREADS 8
+
+double measure_insertion(const int *values, size_t size, double *traversal) ;
+double measure_bulk_build(const int *values, size_t size, size_t threads, double *traversal) ;
+double measure_traversal(BinaryTree *tree, size_t size) ;
+double seconds_since(const struct timespec *start) ;
+
+int main() {
+    const size_t sizes[] = {1000000, 10000000};
+
+    printf("Building AVL trees from sorted values (seconds)%s\n\n", BINARY_TREE_THREADS ? "" : ", without threads");
+    printf("%10s %12s %10s %10s %10s\n", "Length", "Method", "Build", "Speedup", "Traversal");
+
+    for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); ++i) {
+        const size_t size = sizes[i];
+
+        int *values = malloc(size * sizeof(int));
+        if (values == NULL) {
+            perror("Could not allocate memory!");
+            return 1;
+        }
+        for (size_t j = 0; j < size; ++j) {
+            values[j] = (int) (3 * j);
+        }
+
+        double traversal;
+        double insertion = measure_insertion(values, size, &traversal);
+        printf("%10zu %12s %10f %9.1fx %10f\n", size, "insertion", insertion, 1.0, traversal);
+
+        for (size_t threads = 1; threads <= MAX_THREADS; threads *= 2) {
+            char method[16];
+            snprintf(method, sizeof(method), "%zu thread%s", threads, threads == 1 ? "" : "s");
+            double time = measure_bulk_build(values, size, threads, &traversal);
+            printf("%10zu %12s %10f %9.1fx %10f\n", size, method, time, insertion / time, traversal);
+        }
+
+        free(values);
+    }
+
+    return 0;
+}
+
+/// Measures inserting the values one by one into a pooled AVL tree
+/// \param traversal Receives the time of an in-order traversal of the finished tree
+/// \return The elapsed wall clock time in seconds
+double measure_insertion(const int *values, size_t size, double *traversal) {
+    struct timespec start;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    BinaryTree *tree = create_binary_tree_with_mode(BINARY_TREE_AVL, memory_pool_create(sizeof(BinaryTreeNode), 4096));
+    for (size_t i = 0; i < size; ++i) {
+        add_to_binary_tree(tree, values[i]);
+    }
+    double time = seconds_since(&start);
+
+    *traversal = measure_traversal(tree, size);
+    destroy_binary_tree(tree);
+    return time;
+}
+
+/// Measures the bulk build
+/// \param traversal Receives the time of an in-order traversal of the finished tree
+/// \return The elapsed wall clock time in seconds
+double measure_bulk_build(const int *values, size_t size, size_t threads, double *traversal) {
+    struct timespec start;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    BinaryTree *tree = binary_tree_from_sorted_parallel(values, size, threads);
+    double time = seconds_since(&start);
+    if (tree == NULL) {
+        exit(1);
+    }
+
+    *traversal = measure_traversal(tree, size);
+    destroy_binary_tree(tree);
+    return time;
+}
+
+/// Walks through all values in order and checks that none is missing
+/// \return The elapsed wall clock time in seconds
+double measure_traversal(BinaryTree *tree, size_t size) {
+    struct timespec start;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+
+    BinaryTreeIterator iterator = binary_tree_begin(tree);
+    size_t count = 0;
+    int value;
+    while (binary_tree_next(&iterator, &value)) {
+        ++count;
+    }
+    double time = seconds_since(&start);
+
+    if (count != size) {
+        printf("Lost values, found only %zu\n", count);
+    }
+    return time;
+}
+
+double seconds_since(const struct timespec *start) {
+    struct timespec end;
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    return (double) (end.tv_sec - start->tv_sec) + (double) (end.tv_nsec - start->tv_nsec) / 1e9;
+}
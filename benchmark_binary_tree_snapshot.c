@@ -0,0 +1,92 @@
+#include "data_structures.h"
+#include <time.h>
+
+/*
+ * Compares lookups in an AVL Binary Tree with lookups in a frozen snapshot of the same tree.
+ * Build with optimizations, e.g. gcc -std=c99 -O2 benchmark_binary_tree_snapshot.c
+ */
+
+#define SEARCHES 2000000
+
+double measure_tree(BinaryTree *tree, const int *to_search, size_t *found) ;
+double measure_snapshot(const BinaryTreeSnapshot *snapshot, const int *to_search, size_t *found) ;
+
+int main() {
+    const size_t sizes[] = {1000, 65536, 1000000, 4000000};
+    uint64_t state = (uint64_t) time(NULL);
+
+    int *to_search = malloc(SEARCHES * sizeof(int));
+    if (to_search == NULL) {
+        perror("Could not allocate memory!");
+        return 1;
+    }
+
+    printf("Searching %d random values (million lookups per second)\n\n", SEARCHES);
+    printf("%10s %12s %12s %10s %10s\n", "Length", "Tree", "Snapshot", "Speedup", "Freeze (s)");
+
+    for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); ++i) {
+        const size_t size = sizes[i];
+
+        // Even values are stored, so about half of the searches miss
+        MemoryPool *pool = memory_pool_create(sizeof(BinaryTreeNode), 4096);
+        BinaryTree *tree = create_binary_tree_with_mode(BINARY_TREE_AVL, pool);
+        if (tree == NULL) {
+            perror("Could not allocate memory!");
+            free(to_search);
+            return 1;
+        }
+        for (size_t j = 0; j < size; ++j) {
+            add_to_binary_tree(tree, (int) (splitmix64_next(&state) % (2 * size)) & ~1);
+        }
+        for (size_t j = 0; j < SEARCHES; ++j) {
+            to_search[j] = (int) (splitmix64_next(&state) % (2 * size));
+        }
+
+        clock_t start = clock();
+        BinaryTreeSnapshot *snapshot = binary_tree_freeze(tree);
+        double freeze = (double) (clock() - start) / CLOCKS_PER_SEC;
+        if (snapshot == NULL) {
+            destroy_binary_tree(tree);
+            free(to_search);
+            return 1;
+        }
+
+        size_t found_tree, found_snapshot;
+        double tree_time = measure_tree(tree, to_search, &found_tree);
+        double snapshot_time = measure_snapshot(snapshot, to_search, &found_snapshot);
+        if (found_tree != found_snapshot) {
+            printf("Results differ: %zu in the tree, %zu in the snapshot\n", found_tree, found_snapshot);
+        }
+
+        printf("%10zu %12.2f %12.2f %9.1fx %10f\n", size, SEARCHES / tree_time / 1e6,
+               SEARCHES / snapshot_time / 1e6, tree_time / snapshot_time, freeze);
+
+        destroy_binary_tree_snapshot(snapshot);
+        destroy_binary_tree(tree);
+    }
+
+    free(to_search);
+    return 0;
+}
+
+/// Measures the time needed for all searches in the pointer tree
+/// \return The elapsed time in seconds
+double measure_tree(BinaryTree *tree, const int *to_search, size_t *found) {
+    *found = 0;
+    clock_t start = clock();
+    for (size_t i = 0; i < SEARCHES; ++i) {
+        *found += search_in_binary_tree(tree, to_search[i]) != NULL;
+    }
+    return (double) (clock() - start) / CLOCKS_PER_SEC;
+}
+
+/// Measures the time needed for all searches in the snapshot
+/// \return The elapsed time in seconds
+double measure_snapshot(const BinaryTreeSnapshot *snapshot, const int *to_search, size_t *found) {
+    *found = 0;
+    clock_t start = clock();
+    for (size_t i = 0; i < SEARCHES; ++i) {
+        *found += (size_t) binary_tree_snapshot_contains(snapshot, to_search[i]);
+    }
+    return (double) (clock() - start) / CLOCKS_PER_SEC;
+}
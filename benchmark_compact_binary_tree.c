@@ -0,0 +1,104 @@
+#include "data_structures.h"
+#include <time.h>
+
+/*
+ * Compares a plain Binary Tree, with nodes from malloc and from a memory pool, with a Compact Binary Tree holding the
+ * same random values: memory per node and the time to insert, search and destroy.
+ * Build with optimizations, e.g. gcc -std=c99 -O2 benchmark_compact_binary_tree.c
+ */
+
+#define SEARCHES 1000000
+
+typedef enum {MALLOC, POOLED, COMPACT, VARIANT_COUNT} Variant;
+
+const char *variant_names[VARIANT_COUNT] = {"malloc", "pooled", "compact"};
+
+void measure(Variant variant, const int *values, const size_t size, const int *to_search, double *times) ;
+
+int main() {
+    const size_t sizes[] = {10000, 1000000, 4000000};
+    uint64_t state = (uint64_t) time(NULL);
+
+    int *to_search = malloc(SEARCHES * sizeof(int));
+    if (to_search == NULL) {
+        perror("Could not allocate memory!");
+        return 1;
+    }
+
+    printf("Node sizes: %zu bytes for Binary Tree, %zu bytes for Compact Binary Tree\n", sizeof(BinaryTreeNode),
+           sizeof(CompactBinaryTreeNode));
+    printf("Inserting random values, %d searches (seconds)\n\n", SEARCHES);
+    printf("%10s %8s %12s %12s %12s\n", "Length", "Variant", "Insert", "Search", "Destroy");
+
+    for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); ++i) {
+        const size_t size = sizes[i];
+
+        int *values = malloc(size * sizeof(int));
+        if (values == NULL) {
+            perror("Could not allocate memory!");
+            free(to_search);
+            return 1;
+        }
+        for (size_t j = 0; j < size; ++j) {
+            values[j] = (int) (splitmix64_next(&state) >> 33);
+        }
+        for (size_t j = 0; j < SEARCHES; ++j) {
+            to_search[j] = values[splitmix64_next(&state) % size];
+        }
+
+        for (Variant variant = 0; variant < VARIANT_COUNT; ++variant) {
+            double times[3];
+            measure(variant, values, size, to_search, times);
+            printf("%10zu %8s %12f %12f %12f\n", size, variant_names[variant], times[0], times[1], times[2]);
+        }
+
+        free(values);
+    }
+
+    free(to_search);
+    return 0;
+}
+
+/// Builds a tree of the given variant and measures insertion, all searches and destruction
+/// \param times Receives the three elapsed times in seconds
+void measure(Variant variant, const int *values, const size_t size, const int *to_search, double *times) {
+    BinaryTree *tree = NULL;
+    CompactBinaryTree *compact = NULL;
+    size_t found = 0;
+
+    clock_t start = clock();
+    if (variant == COMPACT) {
+        compact = create_compact_binary_tree(0);
+        for (size_t i = 0; i < size; ++i) {
+            compact_binary_tree_add(compact, values[i]);
+        }
+    } else {
+        tree = variant == POOLED ? create_binary_tree_pooled(memory_pool_create(sizeof(BinaryTreeNode), 4096))
+                                 : create_binary_tree();
+        for (size_t i = 0; i < size; ++i) {
+            add_to_binary_tree(tree, values[i]);
+        }
+    }
+    clock_t inserted = clock();
+
+    for (size_t i = 0; i < SEARCHES; ++i) {
+        if (variant == COMPACT) {
+            found += compact_binary_tree_search(compact, to_search[i]) != COMPACT_BINARY_TREE_NIL;
+        } else {
+            found += search_in_binary_tree(tree, to_search[i]) != NULL;
+        }
+    }
+    clock_t searched = clock();
+
+    destroy_compact_binary_tree(compact);
+    destroy_binary_tree(tree);
+    clock_t destroyed = clock();
+
+    if (found != SEARCHES) {
+        printf("Lost values, found only %zu\n", found);
+    }
+
+    times[0] = (double) (inserted - start) / CLOCKS_PER_SEC;
+    times[1] = (double) (searched - inserted) / CLOCKS_PER_SEC;
+    times[2] = (double) (destroyed - searched) / CLOCKS_PER_SEC;
+}
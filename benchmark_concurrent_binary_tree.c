@@ -0,0 +1,154 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include "data_structures.h"
+#include "concurrent_binary_tree.h"
+#include <pthread.h>
+#include <time.h>
+
+/*
+ * Measures the throughput of a Concurrent Binary Tree with a growing number of threads and two mixes of lookups and
+ * updates, and compares it with an AVL Binary Tree behind a single mutex. Updates are half insertions and half
+ * removals of random values, so the size of the set stays about the same.
+ * Build with e.g. gcc -std=c11 -O2 -pthread benchmark_concurrent_binary_tree.c
+ */
+
+#define KEY_RANGE 1000000
+#define MAX_THREADS 32
+#define MILLISECONDS_PER_MEASUREMENT 300
+
+typedef enum {CONCURRENT, LOCKED, VARIANT_COUNT} Variant;
+
+const char *variant_names[VARIANT_COUNT] = {"concurrent", "mutex AVL"};
+
+/// The set all threads work on, only one of the two is used
+typedef struct shared_set {
+    ConcurrentBinaryTree *concurrent;
+    BinaryTree *locked;
+    pthread_mutex_t mutex;
+} SharedSet;
+
+typedef struct worker {
+    pthread_t thread;
+    SharedSet *set;
+    int read_percentage;
+    uint64_t seed;
+    _Atomic int *running;
+    size_t operations;
+} Worker;
+
+void *run_worker(void *argument) ;
+double measure(Variant variant, size_t threads, int read_percentage) ;
+
+int main() {
+    const int read_percentages[] = {90, 50};
+
+    printf("Random operations on values below %d, half of them contained (million operations per second)\n\n",
+           KEY_RANGE);
+    printf("%8s %8s %12s %12s\n", "Reads", "Threads", variant_names[CONCURRENT], variant_names[LOCKED]);
+
+    for (size_t i = 0; i < sizeof(read_percentages) / sizeof(read_percentages[0]); ++i) {
+        for (size_t threads = 1; threads <= MAX_THREADS; threads *= 2) {
+            printf("%7d%% %8zu", read_percentages[i], threads);
+            for (Variant variant = 0; variant < VARIANT_COUNT; ++variant) {
+                printf(" %12.2f", measure(variant, threads, read_percentages[i]));
+            }
+            printf("\n");
+        }
+    }
+
+    return 0;
+}
+
+/// Runs random operations on the shared set until running is cleared
+void *run_worker(void *argument) {
+    Worker *worker = argument;
+    SharedSet *set = worker->set;
+    ConcurrentBinaryTreeThread *handle = set->concurrent ? concurrent_binary_tree_register(set->concurrent) : NULL;
+
+    while (atomic_load_explicit(worker->running, memory_order_relaxed)) {
+        for (size_t i = 0; i < 256; ++i, ++worker->operations) {
+            uint64_t random = splitmix64_next(&worker->seed);
+            int value = (int) (random % KEY_RANGE);
+            int operation = (int) ((random >> 32) % 200);
+
+            if (set->concurrent) {
+                if (operation < 2 * worker->read_percentage) {
+                    concurrent_binary_tree_contains(set->concurrent, handle, value);
+                } else if (operation & 1) {
+                    concurrent_binary_tree_add(set->concurrent, handle, value);
+                } else {
+                    concurrent_binary_tree_remove(set->concurrent, handle, value);
+                }
+            } else {
+                pthread_mutex_lock(&set->mutex);
+                if (operation < 2 * worker->read_percentage) {
+                    search_in_binary_tree(set->locked, value);
+                } else if (operation & 1) {
+                    if (search_in_binary_tree(set->locked, value) == NULL) {
+                        add_to_binary_tree(set->locked, value);
+                    }
+                } else {
+                    delete_binary_tree_node(set->locked, value);
+                }
+                pthread_mutex_unlock(&set->mutex);
+            }
+        }
+    }
+
+    if (handle) {
+        concurrent_binary_tree_unregister(handle);
+    }
+    return NULL;
+}
+
+/// Fills a set with half of the key range and lets the threads work on it for MILLISECONDS_PER_MEASUREMENT
+/// \return The throughput in million operations per second
+double measure(Variant variant, size_t threads, int read_percentage) {
+    SharedSet set = {NULL, NULL, PTHREAD_MUTEX_INITIALIZER};
+    uint64_t seed = 42;
+
+    if (variant == CONCURRENT) {
+        set.concurrent = concurrent_binary_tree_create();
+        ConcurrentBinaryTreeThread *handle = concurrent_binary_tree_register(set.concurrent);
+        for (size_t i = 0; i < KEY_RANGE / 2; ++i) {
+            concurrent_binary_tree_add(set.concurrent, handle, (int) (splitmix64_next(&seed) % KEY_RANGE));
+        }
+        concurrent_binary_tree_unregister(handle);
+    } else {
+        set.locked = create_binary_tree_with_mode(BINARY_TREE_AVL, memory_pool_create(sizeof(BinaryTreeNode), 4096));
+        for (size_t i = 0; i < KEY_RANGE / 2; ++i) {
+            int value = (int) (splitmix64_next(&seed) % KEY_RANGE);
+            if (search_in_binary_tree(set.locked, value) == NULL) {
+                add_to_binary_tree(set.locked, value);
+            }
+        }
+    }
+
+    _Atomic int running = 1;
+    Worker workers[MAX_THREADS];
+    for (size_t i = 0; i < threads; ++i) {
+        workers[i].set = &set;
+        workers[i].read_percentage = read_percentage;
+        workers[i].seed = seed + i;
+        workers[i].running = &running;
+        workers[i].operations = 0;
+        pthread_create(&workers[i].thread, NULL, run_worker, &workers[i]);
+    }
+
+    struct timespec start, end;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    struct timespec duration = {0, MILLISECONDS_PER_MEASUREMENT * 1000000L};
+    nanosleep(&duration, NULL);
+    atomic_store(&running, 0);
+
+    size_t operations = 0;
+    for (size_t i = 0; i < threads; ++i) {
+        pthread_join(workers[i].thread, NULL);
+        operations += workers[i].operations;
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    concurrent_binary_tree_destroy(set.concurrent);
+    destroy_binary_tree(set.locked);
+    return operations / ((double) (end.tv_sec - start.tv_sec) + (double) (end.tv_nsec - start.tv_nsec) / 1e9) / 1e6;
+}
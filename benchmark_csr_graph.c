@@ -0,0 +1,102 @@
+#include "data_structures.h"
+#include <time.h>
+
+/*
+ * Compares a breadth first traversal over an Adjacency List, whose successors are linked lists, with the same
+ * traversal over the CSR Graph converted from it, and the memory both take.
+ * Build with optimizations, e.g. gcc -std=c99 -O2 benchmark_csr_graph.c
+ */
+
+#define AVERAGE_DEGREE 8
+#define TRAVERSALS 5
+
+size_t adjacency_list_breadth_first(const AdjacencyList *list, size_t source, uint32_t *order, unsigned char *visited) ;
+size_t adjacency_list_memory(const AdjacencyList *list) ;
+
+int main() {
+    const size_t sizes[] = {100000, 1000000};
+    uint64_t state = (uint64_t) time(NULL);
+
+    printf("Random graphs with %d edges per node, %d breadth first traversals from node 0\n\n", AVERAGE_DEGREE,
+           TRAVERSALS);
+    printf("%10s %10s %14s %10s %10s %12s %12s\n", "Nodes", "Edges", "Convert (s)", "List (s)", "CSR (s)", "List (MB)",
+           "CSR (MB)");
+
+    for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); ++i) {
+        const size_t size = sizes[i];
+
+        AdjacencyList *list = adjacency_list_create(size);
+        uint32_t *order = malloc(size * sizeof(uint32_t));
+        unsigned char *visited = malloc(size);
+        if (list == NULL || order == NULL || visited == NULL) {
+            perror("Could not allocate memory!");
+            return 1;
+        }
+        for (size_t j = 0; j < size * AVERAGE_DEGREE; ++j) {
+            link_alnodes(list->nodes[splitmix64_next(&state) % size], list->nodes[splitmix64_next(&state) % size]);
+        }
+
+        clock_t start = clock();
+        CsrGraph *graph = adjacency_list_to_csr(list);
+        double conversion = (double) (clock() - start) / CLOCKS_PER_SEC;
+        if (graph == NULL) {
+            return 1;
+        }
+
+        size_t reached_list = 0, reached_graph = 0;
+        start = clock();
+        for (size_t j = 0; j < TRAVERSALS; ++j) {
+            reached_list = adjacency_list_breadth_first(list, 0, order, visited);
+        }
+        double list_time = (double) (clock() - start) / CLOCKS_PER_SEC;
+
+        start = clock();
+        for (size_t j = 0; j < TRAVERSALS; ++j) {
+            reached_graph = csr_graph_breadth_first(graph, 0, order, NULL);
+        }
+        double graph_time = (double) (clock() - start) / CLOCKS_PER_SEC;
+
+        if (reached_list != reached_graph) {
+            printf("Traversals differ: %zu nodes in the list, %zu in the graph\n", reached_list, reached_graph);
+        }
+        printf("%10zu %10zu %14f %10f %10f %12.1f %12.1f\n", size, graph->edge_count, conversion, list_time,
+               graph_time, adjacency_list_memory(list) / 1e6, csr_graph_memory(graph) / 1e6);
+
+        csr_graph_destroy(graph);
+        adjacency_list_destroy(list);
+        free(order);
+        free(visited);
+    }
+
+    return 0;
+}
+
+/// The breadth first traversal of csr_graph_breadth_first() on the linked successor lists
+/// \return The amount of reached nodes
+size_t adjacency_list_breadth_first(const AdjacencyList *list, size_t source, uint32_t *order, unsigned char *visited) {
+    memset(visited, 0, list->size);
+
+    size_t head = 0, tail = 0;
+    order[tail++] = (uint32_t) source;
+    visited[source] = 1;
+    while (head < tail) {
+        AdjacencyListNode *node = list->nodes[order[head++]];
+        for (LinkedListNode *successor = node->successors->head; successor; successor = successor->next) {
+            if (!visited[successor->value]) {
+                visited[successor->value] = 1;
+                order[tail++] = (uint32_t) successor->value;
+            }
+        }
+    }
+    return tail;
+}
+
+/// Adds up the memory requested for all parts of the list, without the overhead of malloc
+size_t adjacency_list_memory(const AdjacencyList *list) {
+    size_t result = sizeof(AdjacencyList) + list->size * (sizeof(AdjacencyListNode *) + sizeof(AdjacencyListNode)
+                                                          + sizeof(LinkedList));
+    for (size_t i = 0; i < list->size; ++i) {
+        result += list->nodes[i]->successors->length * sizeof(LinkedListNode);
+    }
+    return result;
+}
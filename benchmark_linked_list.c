@@ -0,0 +1,103 @@
+#include "data_structures.h"
+#include <time.h>
+
+/*
+ * Compares scanning a Linked List with scanning an Unrolled Linked List holding the same values.
+ * Build with optimizations, e.g. gcc -std=c99 -O3 benchmark_linked_list.c
+ */
+
+#define SEARCHES 200
+
+double measure_linked_list(const int *values, const size_t size, const int *to_search) ;
+double measure_unrolled_linked_list(const int *values, const size_t size, const int *to_search) ;
+
+int main() {
+    const size_t sizes[] = {1000, 10000, 100000, 1000000};
+
+    printf("Scanning %d values in lists of random values (seconds)\n\n", SEARCHES);
+    printf("%10s %14s %14s %10s\n", "Length", "Linked List", "Unrolled", "Speedup");
+
+    srand((unsigned) time(NULL));
+    for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); ++i) {
+        const size_t size = sizes[i];
+
+        int *values = malloc(size * sizeof(int));
+        if (values == NULL) {
+            perror("Could not allocate memory!");
+            return 1;
+        }
+        for (size_t j = 0; j < size; ++j) {
+            values[j] = rand();
+        }
+
+        // Half of the searched values are contained, the other half most likely not
+        int to_search[SEARCHES];
+        for (size_t k = 0; k < SEARCHES; ++k) {
+            to_search[k] = (k % 2) ? values[rand() % size] : rand();
+        }
+
+        double linked = measure_linked_list(values, size, to_search);
+        double unrolled = measure_unrolled_linked_list(values, size, to_search);
+        printf("%10zu %14f %14f %9.1fx\n", size, linked, unrolled, linked / unrolled);
+
+        free(values);
+    }
+
+    return 0;
+}
+
+/// Builds a linked list from values and measures the time needed for all searches and one conversion to an array
+/// \return The elapsed time in seconds
+double measure_linked_list(const int *values, const size_t size, const int *to_search) {
+    LinkedList *list = linked_list_create();
+    for (size_t i = 0; i < size; ++i) {
+        linked_list_add(list, values[i]);
+    }
+
+    int *array = malloc(size * sizeof(int));
+    size_t found = 0;
+
+    clock_t start = clock();
+    for (size_t k = 0; k < SEARCHES; ++k) {
+        found += linked_list_contains(list, to_search[k]);
+    }
+    linked_list_as_array(list, array);
+    clock_t end = clock();
+
+    // Use the results so the work can not be optimized away
+    if (found > SEARCHES || array[0] != values[0]) {
+        printf("Linked list returned wrong results!\n");
+    }
+
+    free(array);
+    linked_list_destroy(list);
+    return (double) (end - start) / CLOCKS_PER_SEC;
+}
+
+/// Builds an unrolled linked list from values and measures the time needed for all searches and one conversion to an
+/// array
+/// \return The elapsed time in seconds
+double measure_unrolled_linked_list(const int *values, const size_t size, const int *to_search) {
+    UnrolledLinkedList *list = unrolled_linked_list_create();
+    for (size_t i = 0; i < size; ++i) {
+        unrolled_linked_list_add(list, values[i]);
+    }
+
+    int *array = malloc(size * sizeof(int));
+    size_t found = 0;
+
+    clock_t start = clock();
+    for (size_t k = 0; k < SEARCHES; ++k) {
+        found += unrolled_linked_list_contains(list, to_search[k]);
+    }
+    unrolled_linked_list_as_array(list, array);
+    clock_t end = clock();
+
+    if (found > SEARCHES || array[0] != values[0]) {
+        printf("Unrolled linked list returned wrong results!\n");
+    }
+
+    free(array);
+    unrolled_linked_list_destroy(list);
+    return (double) (end - start) / CLOCKS_PER_SEC;
+}
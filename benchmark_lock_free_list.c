@@ -0,0 +1,176 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include "data_structures.h"
+#include "lock_free_list.h"
+#include <pthread.h>
+#include <time.h>
+
+/*
+ * Hammers a Lock-Free Linked List with a growing number of threads doing random adds, removes and lookups on a small
+ * key range, checks that the resulting set is consistent and compares the throughput with a Linked List guarded by a
+ * single mutex.
+ * Build with e.g. gcc -std=c11 -O2 -pthread benchmark_lock_free_list.c
+ */
+
+#define KEY_RANGE 1024
+#define OPERATIONS_PER_THREAD 200000
+#define MAX_THREADS 16
+
+typedef struct worker {
+    pthread_t thread;
+    uint64_t seed;
+    LockFreeList *lock_free_list;
+    LinkedList *locked_list;
+    pthread_mutex_t *mutex;
+    long long size_change;
+} Worker;
+
+void *run_lock_free(void *argument) ;
+void *run_locked(void *argument) ;
+double measure(size_t threads_count, int lock_free, int *consistent) ;
+
+int main() {
+    printf("%d operations per thread on %d keys (10%% add, 10%% remove, 80%% contains)\n\n",
+           OPERATIONS_PER_THREAD, KEY_RANGE);
+    printf("%8s %18s %18s %12s\n", "Threads", "Lock-free ops/s", "Mutex ops/s", "Consistent");
+
+    for (size_t threads_count = 1; threads_count <= MAX_THREADS; threads_count *= 2) {
+        int consistent = 1;
+        double lock_free = measure(threads_count, 1, &consistent);
+        double locked = measure(threads_count, 0, &consistent);
+
+        double operations = (double) threads_count * OPERATIONS_PER_THREAD;
+        printf("%8zu %18.0f %18.0f %12s\n", threads_count, operations / lock_free, operations / locked,
+               consistent ? "yes" : "NO");
+        if (!consistent) {
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
+/// Picks the next operation and key from the worker's generator
+/// \param worker The worker
+/// \param key Will hold the key
+/// \return 0 for add, 1 for remove and 2 for contains
+int next_operation(Worker *worker, int *key) {
+    uint64_t random = splitmix64_next(&worker->seed);
+    *key = (int) (random % KEY_RANGE);
+    size_t choice = (random >> 32) % 10;
+    return choice == 0 ? 0 : choice == 1 ? 1 : 2;
+}
+
+void *run_lock_free(void *argument) {
+    Worker *worker = argument;
+    LockFreeListThread *handle = lock_free_list_register(worker->lock_free_list);
+
+    for (size_t i = 0; i < OPERATIONS_PER_THREAD; ++i) {
+        int key;
+        int operation = next_operation(worker, &key);
+        if (operation == 0) {
+            worker->size_change += lock_free_list_add(worker->lock_free_list, handle, key) == 0;
+        } else if (operation == 1) {
+            worker->size_change -= lock_free_list_remove(worker->lock_free_list, handle, key) == 0;
+        } else {
+            lock_free_list_contains(worker->lock_free_list, handle, key);
+        }
+    }
+
+    lock_free_list_unregister(handle);
+    return NULL;
+}
+
+void *run_locked(void *argument) {
+    Worker *worker = argument;
+
+    for (size_t i = 0; i < OPERATIONS_PER_THREAD; ++i) {
+        int key;
+        int operation = next_operation(worker, &key);
+
+        pthread_mutex_lock(worker->mutex);
+        if (operation == 0) {
+            if (!linked_list_contains(worker->locked_list, key)) {
+                linked_list_add_sorted(worker->locked_list, key);
+                ++worker->size_change;
+            }
+        } else if (operation == 1) {
+            worker->size_change -= linked_list_remove(worker->locked_list, key) == 0;
+        } else {
+            linked_list_contains(worker->locked_list, key);
+        }
+        pthread_mutex_unlock(worker->mutex);
+    }
+
+    return NULL;
+}
+
+/// Counts the values of a quiescent lock-free list and checks that they are strictly ascending and unmarked
+/// \return The amount of values or -1 if the list is broken
+long long lock_free_list_verify(LockFreeList *list) {
+    long long count = 0;
+    LockFreeListNode *previous = NULL;
+    uintptr_t next = atomic_load(&list->head->next);
+
+    while (next) {
+        LockFreeListNode *current = (LockFreeListNode *) next;
+        next = atomic_load(&current->next);
+        if ((next & 1) || (previous && previous->value >= current->value)) {
+            return -1;
+        }
+        previous = current;
+        ++count;
+    }
+
+    return count;
+}
+
+/// Prefills a list with every second key, runs all workers and checks the final size
+/// \param threads_count The amount of threads
+/// \param lock_free 1 to use the lock-free list, 0 for the mutex guarded linked list
+/// \param consistent Set to 0 if the final list does not match the successful operations
+/// \return The elapsed wall clock time in seconds
+double measure(size_t threads_count, int lock_free, int *consistent) {
+    LockFreeList *lock_free_list = lock_free_list_create();
+    LinkedList *locked_list = linked_list_create();
+    pthread_mutex_t mutex;
+    pthread_mutex_init(&mutex, NULL);
+
+    LockFreeListThread *handle = lock_free_list_register(lock_free_list);
+    long long expected_size = 0;
+    for (int key = 0; key < KEY_RANGE; key += 2) {
+        lock_free_list_add(lock_free_list, handle, key);
+        linked_list_add(locked_list, key);
+        ++expected_size;
+    }
+    lock_free_list_unregister(handle);
+
+    Worker workers[MAX_THREADS];
+    struct timespec start, end;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+
+    for (size_t i = 0; i < threads_count; ++i) {
+        workers[i].seed = i + 1;
+        workers[i].lock_free_list = lock_free_list;
+        workers[i].locked_list = locked_list;
+        workers[i].mutex = &mutex;
+        workers[i].size_change = 0;
+        pthread_create(&workers[i].thread, NULL, lock_free ? run_lock_free : run_locked, &workers[i]);
+    }
+    for (size_t i = 0; i < threads_count; ++i) {
+        pthread_join(workers[i].thread, NULL);
+        expected_size += workers[i].size_change;
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    long long size = lock_free ? lock_free_list_verify(lock_free_list) : (long long) linked_list_get_length(locked_list);
+    if (size != expected_size) {
+        *consistent = 0;
+    }
+
+    pthread_mutex_destroy(&mutex);
+    linked_list_destroy(locked_list);
+    lock_free_list_destroy(lock_free_list);
+    return (double) (end.tv_sec - start.tv_sec) + (double) (end.tv_nsec - start.tv_nsec) / 1e9;
+}
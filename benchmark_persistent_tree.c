@@ -0,0 +1,145 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include "data_structures.h"
+#include "persistent_tree.h"
+#include <pthread.h>
+#include <time.h>
+
+/*
+ * Runs one writer which keeps adding and removing random values in a Persistent Tree while a growing number of readers
+ * repeatedly acquire the current version and scan all of it. Every scan checks that its version is sorted and complete,
+ * and the throughput of readers and writer is reported.
+ * Build with e.g. gcc -std=c11 -O2 -pthread benchmark_persistent_tree.c
+ */
+
+#define TREE_SIZE 100000
+#define KEY_RANGE 200000
+#define SECONDS_PER_MEASUREMENT 1
+#define MAX_READERS 8
+
+typedef struct reader {
+    pthread_t thread;
+    PersistentTree *tree;
+    _Atomic int *running;
+    size_t scans;
+    int consistent;
+} Reader;
+
+typedef struct scan_state {
+    long long previous;
+    size_t count;
+    int sorted;
+} ScanState;
+
+int check_value(int value, void *context) ;
+void *run_reader(void *argument) ;
+double measure(size_t readers_count, size_t *scans, size_t *updates, int *consistent) ;
+
+int main() {
+    printf("One writer on %d values, readers scanning whole versions for %d second(s)\n\n", TREE_SIZE,
+           SECONDS_PER_MEASUREMENT);
+    printf("%8s %14s %16s %12s\n", "Readers", "Scans/s", "Updates/s", "Consistent");
+
+    const size_t readers_counts[] = {0, 1, 2, 4, MAX_READERS};
+    for (size_t i = 0; i < sizeof(readers_counts) / sizeof(readers_counts[0]); ++i) {
+        const size_t readers_count = readers_counts[i];
+        size_t scans, updates;
+        int consistent = 1;
+        double time = measure(readers_count, &scans, &updates, &consistent);
+
+        printf("%8zu %14.0f %16.0f %12s\n", readers_count, scans / time, updates / time, consistent ? "yes" : "NO");
+        if (!consistent) {
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
+/// Checks that the values of a scan arrive in ascending order
+int check_value(int value, void *context) {
+    ScanState *state = context;
+    if (value < state->previous) {
+        state->sorted = 0;
+    }
+    state->previous = value;
+    ++state->count;
+    return 0;
+}
+
+/// Scans whole versions until the writer is done
+void *run_reader(void *argument) {
+    Reader *reader = argument;
+
+    while (atomic_load(reader->running)) {
+        PersistentTreeNode *version = persistent_tree_acquire(reader->tree);
+
+        ScanState state = {-1, 0, 1};
+        persistent_tree_range_scan(version, 0, KEY_RANGE, check_value, &state);
+        if (!state.sorted || state.count != persistent_tree_size(version)) {
+            reader->consistent = 0;
+        }
+
+        persistent_tree_release(version);
+        ++reader->scans;
+    }
+    return NULL;
+}
+
+/// Fills a tree, starts the readers and lets the writer update the tree for SECONDS_PER_MEASUREMENT
+/// \param readers_count The amount of reader threads
+/// \param scans Receives the amount of finished scans of all readers
+/// \param updates Receives the amount of updates of the writer
+/// \param consistent Set to 0 if any scan saw an inconsistent version
+/// \return The elapsed wall clock time in seconds
+double measure(size_t readers_count, size_t *scans, size_t *updates, int *consistent) {
+    PersistentTree *tree = persistent_tree_create();
+    int *values = malloc(TREE_SIZE * sizeof(int));
+    if (tree == NULL || values == NULL) {
+        perror("Could not allocate memory!");
+        exit(1);
+    }
+
+    uint64_t seed = 42;
+    for (size_t i = 0; i < TREE_SIZE; ++i) {
+        values[i] = (int) (splitmix64_next(&seed) % KEY_RANGE);
+        persistent_tree_add(tree, values[i]);
+    }
+
+    _Atomic int running = 1;
+    Reader readers[MAX_READERS];
+    for (size_t i = 0; i < readers_count; ++i) {
+        readers[i].tree = tree;
+        readers[i].running = &running;
+        readers[i].scans = 0;
+        readers[i].consistent = 1;
+        pthread_create(&readers[i].thread, NULL, run_reader, &readers[i]);
+    }
+
+    struct timespec start, now;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    *updates = 0;
+    do {
+        // Replace the oldest value by a new one, so the size stays constant
+        for (size_t i = 0; i < 1000; ++i, *updates += 2) {
+            size_t oldest = *updates / 2 % TREE_SIZE;
+            persistent_tree_delete(tree, values[oldest]);
+            values[oldest] = (int) (splitmix64_next(&seed) % KEY_RANGE);
+            persistent_tree_add(tree, values[oldest]);
+        }
+        clock_gettime(CLOCK_MONOTONIC, &now);
+    } while (now.tv_sec - start.tv_sec < SECONDS_PER_MEASUREMENT);
+
+    atomic_store(&running, 0);
+    *scans = 0;
+    for (size_t i = 0; i < readers_count; ++i) {
+        pthread_join(readers[i].thread, NULL);
+        *scans += readers[i].scans;
+        *consistent &= readers[i].consistent;
+    }
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    persistent_tree_destroy(tree);
+    free(values);
+    return (double) (now.tv_sec - start.tv_sec) + (double) (now.tv_nsec - start.tv_nsec) / 1e9;
+}
@@ -0,0 +1,101 @@
+#include "simd.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+/*
+ * Compares the scalar, SSE2 and AVX2 versions of the kernels in simd.h on arrays from 16 to 10M elements.
+ * All kernels have to look at every element: find searches a missing value, the sortedness check runs on an ascending
+ * array and the heap check on a descending one.
+ * Build with optimizations, e.g. gcc -std=c99 -O2 benchmark_simd.c
+ */
+
+#define ELEMENTS_PER_MEASUREMENT 50000000
+
+typedef enum {FIND, COUNT, MIN, MAX, SUM, SORTED, HEAP, KERNEL_COUNT} Kernel;
+
+const char *kernel_names[KERNEL_COUNT] = {"find", "count", "min", "max", "sum", "sorted", "heap"};
+
+double measure(Kernel kernel, const int *ascending, const int *descending, const size_t size) ;
+
+int main() {
+    const size_t sizes[] = {16, 256, 4096, 65536, 1048576, 10000000};
+    const size_t maximum_size = sizes[sizeof(sizes) / sizeof(sizes[0]) - 1];
+    const SimdLevel levels[] = {SIMD_LEVEL_SCALAR, SIMD_LEVEL_SSE2, SIMD_LEVEL_AVX2};
+
+    int *ascending = malloc(maximum_size * sizeof(int));
+    int *descending = malloc(maximum_size * sizeof(int));
+    if (ascending == NULL || descending == NULL) {
+        perror("Could not allocate memory!");
+        free(ascending);
+        free(descending);
+        return 1;
+    }
+
+    printf("Detected level: %s\n", simd_detect_level() == SIMD_LEVEL_AVX2 ? "AVX2"
+                                   : simd_detect_level() == SIMD_LEVEL_SSE2 ? "SSE2" : "scalar");
+    printf("Nanoseconds per element\n\n");
+    printf("%10s %8s %10s %10s %10s %10s\n", "Length", "Kernel", "Scalar", "SSE2", "AVX2", "Speedup");
+
+    for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); ++i) {
+        const size_t size = sizes[i];
+
+        // Start at the array end so every size has the same value distribution
+        for (size_t j = 0; j < size; ++j) {
+            ascending[j] = (int) (j * 2);
+            descending[j] = (int) ((size - j) * 2);
+        }
+
+        for (Kernel kernel = 0; kernel < KERNEL_COUNT; ++kernel) {
+            double times[3];
+            for (size_t k = 0; k < 3; ++k) {
+                simd_set_level(levels[k]);
+                times[k] = measure(kernel, ascending, descending, size);
+            }
+            printf("%10zu %8s %10.3f %10.3f %10.3f %9.1fx\n", size, kernel_names[kernel], times[0], times[1], times[2],
+                   times[0] / times[2]);
+        }
+    }
+
+    free(ascending);
+    free(descending);
+    return 0;
+}
+
+/// Runs a kernel once
+/// \return The result of the kernel, to be used so the call can not be optimized away
+int64_t run(Kernel kernel, const int *ascending, const int *descending, const size_t size) {
+    switch (kernel) {
+        case FIND:
+            return (int64_t) simd_find_first(ascending, size, -1);
+        case COUNT:
+            return (int64_t) simd_count_equal(ascending, size, 42);
+        case MIN:
+            return (int64_t) simd_min_index(ascending, size);
+        case MAX:
+            return (int64_t) simd_max_index(ascending, size);
+        case SUM:
+            return simd_sum(ascending, size);
+        case SORTED:
+            return simd_is_sorted(ascending, size);
+        case HEAP:
+            return simd_is_max_heap(descending, size);
+        default:
+            return 0;
+    }
+}
+
+/// Repeats a kernel until ELEMENTS_PER_MEASUREMENT elements have been processed
+/// \return The time per element in nanoseconds
+double measure(Kernel kernel, const int *ascending, const int *descending, const size_t size) {
+    size_t repetitions = ELEMENTS_PER_MEASUREMENT / size;
+    volatile int64_t sink = 0;
+
+    clock_t start = clock();
+    for (size_t i = 0; i < repetitions; ++i) {
+        sink += run(kernel, ascending, descending, size);
+    }
+    clock_t end = clock();
+
+    return (double) (end - start) / CLOCKS_PER_SEC * 1e9 / ((double) repetitions * (double) size);
+}
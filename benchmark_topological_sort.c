@@ -0,0 +1,133 @@
+#include "data_structures.h"
+#include <time.h>
+
+/*
+ * Measures the topological sort of large random dependency graphs in CSR form, once acyclic and once with a single
+ * edge closing a cycle, and checks that every edge of the sorted graph points forward.
+ * Build with optimizations, e.g. gcc -std=c99 -O2 benchmark_topological_sort.c
+ */
+
+#define AVERAGE_DEGREE 8
+
+CsrGraph *random_dag(size_t size, int cyclic, uint64_t *state) ;
+int is_topological_order(const CsrGraph *graph, const uint32_t *order) ;
+
+int main() {
+    const size_t sizes[] = {100000, 1000000, 4000000};
+    uint64_t state = (uint64_t) time(NULL);
+
+    printf("Random graphs with %d edges per node (seconds)\n\n", AVERAGE_DEGREE);
+    printf("%10s %10s %12s %12s %12s\n", "Nodes", "Edges", "Acyclic", "Cyclic", "Cycle");
+
+    for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); ++i) {
+        const size_t size = sizes[i];
+        double times[2];
+        size_t edges = 0, cycle_length = 0;
+
+        uint32_t *order = malloc(size * sizeof(uint32_t));
+        uint32_t *cycle = malloc(size * sizeof(uint32_t));
+        if (order == NULL || cycle == NULL) {
+            perror("Could not allocate memory!");
+            return 1;
+        }
+
+        for (int cyclic = 0; cyclic <= 1; ++cyclic) {
+            CsrGraph *graph = random_dag(size, cyclic, &state);
+            if (graph == NULL) {
+                return 1;
+            }
+            if (!cyclic) {
+                edges = graph->edge_count;
+            }
+
+            clock_t start = clock();
+            int status = csr_graph_topological_sort(graph, order, cycle, &cycle_length);
+            times[cyclic] = (double) (clock() - start) / CLOCKS_PER_SEC;
+
+            if (status != (cyclic ? 2 : 0) || (!cyclic && !is_topological_order(graph, order))) {
+                printf("Wrong result for %zu nodes: %d\n", size, status);
+            }
+            csr_graph_destroy(graph);
+        }
+
+        printf("%10zu %10zu %12f %12f %12zu\n", size, edges, times[0], times[1], cycle_length);
+        free(order);
+        free(cycle);
+    }
+
+    return 0;
+}
+
+/// Builds a random acyclic graph by letting every edge point from a lower to a higher rank of a random permutation
+/// \param cyclic If set, one more edge closes a cycle through the nodes of lowest and highest rank
+/// \return The graph or NULL in case of memory error
+CsrGraph *random_dag(size_t size, int cyclic, uint64_t *state) {
+    const size_t edge_count = size * AVERAGE_DEGREE;
+    uint32_t *ranks = malloc(size * sizeof(uint32_t));
+    uint32_t *sources = malloc((edge_count + 1) * sizeof(uint32_t));
+    uint32_t *targets = malloc((edge_count + 1) * sizeof(uint32_t));
+    if (ranks == NULL || sources == NULL || targets == NULL) {
+        perror("Could not allocate memory!");
+        free(ranks);
+        free(sources);
+        free(targets);
+        return NULL;
+    }
+
+    // ranks[r] is the node of rank r
+    for (size_t i = 0; i < size; ++i) {
+        ranks[i] = (uint32_t) i;
+    }
+    for (size_t i = size - 1; i > 0; --i) {
+        size_t j = splitmix64_next(state) % (i + 1);
+        uint32_t swap = ranks[i];
+        ranks[i] = ranks[j];
+        ranks[j] = swap;
+    }
+
+    size_t count = 0;
+    while (count < edge_count) {
+        size_t a = splitmix64_next(state) % size, b = splitmix64_next(state) % size;
+        if (a != b) {
+            sources[count] = ranks[a < b ? a : b];
+            targets[count++] = ranks[a < b ? b : a];
+        }
+    }
+
+    // Replace the first edge by one from the lowest to the highest rank and add its way back
+    if (cyclic) {
+        sources[count] = ranks[size - 1];
+        targets[count++] = ranks[0];
+        sources[0] = ranks[0];
+        targets[0] = ranks[size - 1];
+    }
+
+    CsrGraph *result = csr_graph_from_edges(size, sources, targets, count);
+    free(ranks);
+    free(sources);
+    free(targets);
+    return result;
+}
+
+/// Checks that every edge points to a node later in the order
+int is_topological_order(const CsrGraph *graph, const uint32_t *order) {
+    uint32_t *positions = malloc(graph->node_count * sizeof(uint32_t));
+    if (positions == NULL) {
+        return 0;
+    }
+    for (size_t i = 0; i < graph->node_count; ++i) {
+        positions[order[i]] = (uint32_t) i;
+    }
+
+    int result = 1;
+    for (uint32_t node = 0; node < graph->node_count; ++node) {
+        for (size_t edge = graph->offsets[node]; edge < graph->offsets[node + 1]; ++edge) {
+            if (positions[graph->targets[edge]] <= positions[node]) {
+                result = 0;
+            }
+        }
+    }
+
+    free(positions);
+    return result;
+}
@@ -0,0 +1,130 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include "data_structures.h"
+#include "treap.h"
+#include <time.h>
+
+/*
+ * Measures union, intersection and difference of two large Treaps with a growing number of threads, and compares the
+ * union with inserting every value of the second set into an AVL Binary Tree holding the first one.
+ * Build with e.g. gcc -std=c99 -O2 -pthread benchmark_treap.c
+ */
+
+#define SET_SIZE 4000000
+#define KEY_RANGE 16000000
+#define MAX_THREADS 16
+
+const char *operation_names[] = {"union", "intersection", "difference"};
+
+int *random_sorted_values(uint64_t *state) ;
+double measure_treap(TreapOperation operation, const int *a, const int *b, size_t threads, size_t *result_size) ;
+double measure_binary_tree(const int *a, const int *b) ;
+double seconds_since(const struct timespec *start) ;
+
+int main() {
+    uint64_t state = (uint64_t) time(NULL);
+    int *a = random_sorted_values(&state);
+    int *b = random_sorted_values(&state);
+    if (a == NULL || b == NULL) {
+        perror("Could not allocate memory!");
+        free(a);
+        free(b);
+        return 1;
+    }
+
+    printf("Two sets of %d random values out of %d (seconds)\n\n", SET_SIZE, KEY_RANGE);
+    printf("%13s %8s %10s %10s %10s\n", "Operation", "Threads", "Time", "Speedup", "Size");
+
+    for (TreapOperation operation = TREAP_UNION; operation <= TREAP_DIFFERENCE; ++operation) {
+        double sequential = 0;
+        for (size_t threads = 1; threads <= MAX_THREADS; threads *= 2) {
+            size_t size;
+            double time = measure_treap(operation, a, b, threads, &size);
+            if (threads == 1) {
+                sequential = time;
+            }
+            printf("%13s %8zu %10f %9.1fx %10zu\n", operation_names[operation], threads, time, sequential / time, size);
+        }
+    }
+
+    printf("\nUnion by inserting into an AVL Binary Tree: %f\n", measure_binary_tree(a, b));
+
+    free(a);
+    free(b);
+    return 0;
+}
+
+/// Draws SET_SIZE random values and sorts them, duplicates are kept
+/// \param state The state of the random generator
+/// \return The values or NULL in case of memory error
+int *random_sorted_values(uint64_t *state) {
+    int *result = malloc(SET_SIZE * sizeof(int));
+    if (result == NULL) {
+        return NULL;
+    }
+
+    // Counting sort over the key range is cheaper than sorting the values
+    unsigned char *counts = calloc(KEY_RANGE, 1);
+    if (counts == NULL) {
+        free(result);
+        return NULL;
+    }
+    for (size_t i = 0; i < SET_SIZE; ++i) {
+        ++counts[splitmix64_next(state) % KEY_RANGE];
+    }
+
+    size_t index = 0;
+    for (size_t key = 0; key < KEY_RANGE; ++key) {
+        for (unsigned char i = 0; i < counts[key]; ++i) {
+            result[index++] = (int) key;
+        }
+    }
+
+    free(counts);
+    return result;
+}
+
+/// Builds both treaps and measures the time of one set operation
+/// \param result_size Receives the size of the resulting set
+/// \return The elapsed wall clock time in seconds
+double measure_treap(TreapOperation operation, const int *a, const int *b, size_t threads, size_t *result_size) {
+    Treap *first = treap_create_from_sorted(a, SET_SIZE);
+    Treap *second = treap_create_from_sorted(b, SET_SIZE);
+
+    struct timespec start;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    treap_apply(operation, first, second, threads);
+    double time = seconds_since(&start);
+
+    *result_size = treap_size(first);
+    treap_destroy(first);
+    treap_destroy(second);
+    return time;
+}
+
+/// Builds an AVL tree from the first set and measures the time needed to insert the values of the second set
+/// \return The elapsed wall clock time in seconds
+double measure_binary_tree(const int *a, const int *b) {
+    BinaryTree *tree = create_binary_tree_with_mode(BINARY_TREE_AVL, memory_pool_create(sizeof(BinaryTreeNode), 4096));
+    for (size_t i = 0; i < SET_SIZE; ++i) {
+        add_to_binary_tree(tree, a[i]);
+    }
+
+    struct timespec start;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (size_t i = 0; i < SET_SIZE; ++i) {
+        if (search_in_binary_tree(tree, b[i]) == NULL) {
+            add_to_binary_tree(tree, b[i]);
+        }
+    }
+    double time = seconds_since(&start);
+
+    destroy_binary_tree(tree);
+    return time;
+}
+
+double seconds_since(const struct timespec *start) {
+    struct timespec end;
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    return (double) (end.tv_sec - start->tv_sec) + (double) (end.tv_nsec - start->tv_nsec) / 1e9;
+}
@@ -0,0 +1,536 @@
+#ifndef CONCURRENT_BINARY_TREE_H
+#define CONCURRENT_BINARY_TREE_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdatomic.h>
+#include <sched.h>
+
+/*
+ * CONCURRENT BINARY TREE
+ *
+ * A sorted set of ints which any number of threads may modify and query at the same time. Every node carries a
+ * version lock: one word holding a lock bit, an unlinked bit and a counter which is incremented whenever a locked node
+ * is unlocked again.
+ *
+ * Lookups never lock and never wait. They only read links and check afterwards that the node they read from was still
+ * part of the tree, which it was if its unlinked bit is not set. Nodes are never moved to a different place of the
+ * tree, so the range of values a linked node is responsible for can only grow, and a validated path is always right.
+ *
+ * Writers search the same way and then lock only the nodes they modify: an insertion locks the future parent, a
+ * removal the node and its parent. The parent is locked with a compare-and-swap from the version seen during the
+ * search, so a parent which changed in the meantime makes the writer search again. A node with two children is only
+ * marked as absent and stays in the tree as a routing node until it loses a child.
+ *
+ * The tree is not rebalanced, so its height depends on the insertion order like the one of a plain Binary Tree.
+ *
+ * Unlinked nodes are reclaimed with epochs as in the Lock-Free Linked List: every thread registers once and passes its
+ * handle to all operations. Uses C11 atomics, compile with -pthread.
+ */
+
+
+#define CONCURRENT_BINARY_TREE_MAX_THREADS 64
+#define CONCURRENT_BINARY_TREE_EPOCHS 3
+#define CONCURRENT_BINARY_TREE_RETIRE_THRESHOLD 64
+
+#define CONCURRENT_BINARY_TREE_LOCKED ((uint64_t) 1)
+#define CONCURRENT_BINARY_TREE_UNLINKED ((uint64_t) 2)
+#define CONCURRENT_BINARY_TREE_VERSION_STEP ((uint64_t) 4)
+
+// DATA STRUCTURES
+
+typedef struct concurrent_binary_tree_node ConcurrentBinaryTreeNode;
+
+/// children[0] is the left and children[1] the right child. present is 0 for values which were removed while the node
+/// had two children. parent is only changed while holding the locks of the old and the new parent
+struct concurrent_binary_tree_node {
+    int value;
+    _Atomic int present;
+    _Atomic uint64_t version;
+    _Atomic(ConcurrentBinaryTreeNode *) children[2];
+    _Atomic(ConcurrentBinaryTreeNode *) parent;
+    ConcurrentBinaryTreeNode *next_retired;
+};
+
+/// The epoch state of a registered thread. state is 0 while the thread is outside of an operation, else the epoch it
+/// announced shifted left by one with the lowest bit set. The retired lists are only touched by the owning thread
+typedef struct concurrent_binary_tree_thread {
+    _Atomic size_t state;
+    _Atomic int in_use;
+    ConcurrentBinaryTreeNode *retired[CONCURRENT_BINARY_TREE_EPOCHS];
+    size_t retired_epoch[CONCURRENT_BINARY_TREE_EPOCHS];
+    size_t retired_count;
+    char padding[64];
+} ConcurrentBinaryTreeThread;
+
+/// The actual root is the right child of holder, a sentinel which is never unlinked and whose value is never looked at
+typedef struct concurrent_binary_tree {
+    ConcurrentBinaryTreeNode *holder;
+    _Atomic size_t epoch;
+    ConcurrentBinaryTreeThread threads[CONCURRENT_BINARY_TREE_MAX_THREADS];
+} ConcurrentBinaryTree;
+
+// CONSTRUCTORS AND DESTRUCTORS
+
+/// Creates a new node which is present and has no children
+/// \param value The node's value
+/// \return A pointer to the new node or NULL if memory allocation failed
+ConcurrentBinaryTreeNode *concurrent_binary_tree_node_create(int value) {
+    ConcurrentBinaryTreeNode *result = malloc(sizeof(ConcurrentBinaryTreeNode));
+    if (result == NULL) {
+        perror("Could not allocate memory!");
+        return NULL;
+    }
+
+    result->value = value;
+    atomic_init(&result->present, 1);
+    atomic_init(&result->version, (uint64_t) 0);
+    atomic_init(&result->children[0], NULL);
+    atomic_init(&result->children[1], NULL);
+    atomic_init(&result->parent, NULL);
+    result->next_retired = NULL;
+
+    return result;
+}
+
+/// Frees a chain of retired nodes
+/// \param node The first node of the chain
+void concurrent_binary_tree_free_retired(ConcurrentBinaryTreeNode *node) {
+    while (node) {
+        ConcurrentBinaryTreeNode *next = node->next_retired;
+        free(node);
+        node = next;
+    }
+}
+
+/// Creates an empty tree
+/// \return A pointer to the tree or NULL if memory allocation failed
+ConcurrentBinaryTree *concurrent_binary_tree_create() {
+    ConcurrentBinaryTree *result = calloc(1, sizeof(ConcurrentBinaryTree));
+    if (result == NULL) {
+        return NULL;
+    }
+
+    result->holder = concurrent_binary_tree_node_create(0);
+    if (result->holder == NULL) {
+        free(result);
+        return NULL;
+    }
+
+    atomic_init(&result->epoch, (size_t) CONCURRENT_BINARY_TREE_EPOCHS);
+    for (size_t i = 0; i < CONCURRENT_BINARY_TREE_MAX_THREADS; ++i) {
+        atomic_init(&result->threads[i].state, (size_t) 0);
+        atomic_init(&result->threads[i].in_use, 0);
+    }
+
+    return result;
+}
+
+/// Destroys the tree including all nodes still waiting for reclamation. No thread may use the tree anymore
+/// \param tree The tree to destroy
+/// \return A NULL pointer to be used for overwriting the object pointer
+ConcurrentBinaryTree *concurrent_binary_tree_destroy(ConcurrentBinaryTree *tree) {
+    if (tree) {
+        // Rotating every left child up turns the tree into a chain of right children, which is freed while walking down
+        ConcurrentBinaryTreeNode *node = tree->holder;
+        while (node) {
+            ConcurrentBinaryTreeNode *left = atomic_load_explicit(&node->children[0], memory_order_relaxed);
+            if (left) {
+                atomic_store_explicit(&node->children[0], atomic_load_explicit(&left->children[1],
+                                                                               memory_order_relaxed),
+                                      memory_order_relaxed);
+                atomic_store_explicit(&left->children[1], node, memory_order_relaxed);
+                node = left;
+            } else {
+                ConcurrentBinaryTreeNode *right = atomic_load_explicit(&node->children[1], memory_order_relaxed);
+                free(node);
+                node = right;
+            }
+        }
+
+        for (size_t i = 0; i < CONCURRENT_BINARY_TREE_MAX_THREADS; ++i) {
+            for (size_t j = 0; j < CONCURRENT_BINARY_TREE_EPOCHS; ++j) {
+                concurrent_binary_tree_free_retired(tree->threads[i].retired[j]);
+            }
+        }
+    }
+    free(tree);
+    return NULL;
+}
+
+/// Registers the calling thread with the tree. Every thread needs its own handle
+/// \param tree The tree to use
+/// \return The thread's handle or NULL if CONCURRENT_BINARY_TREE_MAX_THREADS threads are registered already
+ConcurrentBinaryTreeThread *concurrent_binary_tree_register(ConcurrentBinaryTree *tree) {
+    for (size_t i = 0; i < CONCURRENT_BINARY_TREE_MAX_THREADS; ++i) {
+        int expected = 0;
+        if (atomic_compare_exchange_strong(&tree->threads[i].in_use, &expected, 1)) {
+            return &tree->threads[i];
+        }
+    }
+    return NULL;
+}
+
+/// Gives a thread handle back. Nodes the thread retired are reclaimed later by whoever registers next in its place,
+/// or by concurrent_binary_tree_destroy()
+/// \param thread The handle of the calling thread
+void concurrent_binary_tree_unregister(ConcurrentBinaryTreeThread *thread) {
+    atomic_store(&thread->in_use, 0);
+}
+
+// FUNCTIONS
+
+/// Frees all retired nodes of the thread which no other thread can reach anymore
+/// \param tree The tree
+/// \param thread The handle of the calling thread
+/// \param epoch The current global epoch
+void concurrent_binary_tree_reclaim(ConcurrentBinaryTree *tree, ConcurrentBinaryTreeThread *thread, size_t epoch) {
+    for (size_t i = 0; i < CONCURRENT_BINARY_TREE_EPOCHS; ++i) {
+        if (thread->retired[i] && thread->retired_epoch[i] + 2 <= epoch) {
+            concurrent_binary_tree_free_retired(thread->retired[i]);
+            thread->retired[i] = NULL;
+        }
+    }
+}
+
+/// Starts an operation by announcing the current epoch
+/// \param tree The tree
+/// \param thread The handle of the calling thread
+void concurrent_binary_tree_enter(ConcurrentBinaryTree *tree, ConcurrentBinaryTreeThread *thread) {
+    size_t epoch = atomic_load(&tree->epoch);
+    atomic_store(&thread->state, (epoch << 1) | 1);
+    concurrent_binary_tree_reclaim(tree, thread, epoch);
+}
+
+/// Ends an operation. From now on the thread holds no pointers into the tree
+/// \param thread The handle of the calling thread
+void concurrent_binary_tree_exit(ConcurrentBinaryTreeThread *thread) {
+    atomic_store(&thread->state, (size_t) 0);
+}
+
+/// Advances the global epoch if every thread inside an operation has announced the current one
+/// \param tree The tree
+/// \return The global epoch after the attempt
+size_t concurrent_binary_tree_try_advance(ConcurrentBinaryTree *tree) {
+    size_t epoch = atomic_load(&tree->epoch);
+
+    for (size_t i = 0; i < CONCURRENT_BINARY_TREE_MAX_THREADS; ++i) {
+        size_t state = atomic_load(&tree->threads[i].state);
+        if ((state & 1) && (state >> 1) != epoch) {
+            return epoch;
+        }
+    }
+
+    if (atomic_compare_exchange_strong(&tree->epoch, &epoch, epoch + 1)) {
+        return epoch + 1;
+    }
+    return epoch;
+}
+
+/// Hands an unlinked node over for reclamation, tagged with the epoch read after unlinking it
+/// \param tree The tree
+/// \param thread The handle of the calling thread
+/// \param node The node which was just unlinked by this thread
+void concurrent_binary_tree_retire(ConcurrentBinaryTree *tree, ConcurrentBinaryTreeThread *thread,
+                                   ConcurrentBinaryTreeNode *node) {
+    size_t epoch = atomic_load(&tree->epoch);
+    size_t index = epoch % CONCURRENT_BINARY_TREE_EPOCHS;
+
+    // The slot of this epoch can only hold nodes from at least three epochs ago, which are safe to free
+    if (thread->retired[index] && thread->retired_epoch[index] != epoch) {
+        concurrent_binary_tree_free_retired(thread->retired[index]);
+        thread->retired[index] = NULL;
+    }
+
+    node->next_retired = thread->retired[index];
+    thread->retired[index] = node;
+    thread->retired_epoch[index] = epoch;
+
+    if (++thread->retired_count % CONCURRENT_BINARY_TREE_RETIRE_THRESHOLD == 0) {
+        concurrent_binary_tree_reclaim(tree, thread, concurrent_binary_tree_try_advance(tree));
+    }
+}
+
+/// Locks a node, waiting for the current owner of the lock if there is one
+/// \param node The node to lock
+/// \return The version of the node, including the unlinked bit, while it is locked by the calling thread
+uint64_t concurrent_binary_tree_lock(ConcurrentBinaryTreeNode *node) {
+    while (1) {
+        uint64_t version = atomic_load(&node->version);
+        if (!(version & CONCURRENT_BINARY_TREE_LOCKED)
+            && atomic_compare_exchange_weak(&node->version, &version, version | CONCURRENT_BINARY_TREE_LOCKED)) {
+            return version;
+        }
+        sched_yield();
+    }
+}
+
+/// Locks a node only if it still has a version seen earlier, i.e. if it did not change since then
+/// \param node The node to lock
+/// \param version The version seen while the node was read
+/// \return 1 if the node is locked now, else 0
+int concurrent_binary_tree_try_lock(ConcurrentBinaryTreeNode *node, uint64_t version) {
+    if (version & (CONCURRENT_BINARY_TREE_LOCKED | CONCURRENT_BINARY_TREE_UNLINKED)) {
+        return 0;
+    }
+    return atomic_compare_exchange_strong(&node->version, &version, version | CONCURRENT_BINARY_TREE_LOCKED);
+}
+
+/// Unlocks a node which the calling thread locked and gives it a new version
+/// \param node The node to unlock
+void concurrent_binary_tree_unlock(ConcurrentBinaryTreeNode *node) {
+    uint64_t version = atomic_load_explicit(&node->version, memory_order_relaxed);
+    atomic_store(&node->version, (version & ~CONCURRENT_BINARY_TREE_LOCKED) + CONCURRENT_BINARY_TREE_VERSION_STEP);
+}
+
+/// Returns 1 if a node was unlinked from the tree
+int concurrent_binary_tree_is_unlinked(ConcurrentBinaryTreeNode *node) {
+    return (atomic_load(&node->version) & CONCURRENT_BINARY_TREE_UNLINKED) != 0;
+}
+
+/// Searches a value without locking. Every link is validated by reading the version of its node before and after it
+/// \param tree The tree to search in
+/// \param value The value to search for
+/// \param parent Receives the node whose child was returned
+/// \param direction Receives 0 if the returned node is the left child of parent, 1 if it is the right one
+/// \param parent_version Receives the version parent had while the returned link was read
+/// \return The node holding value, whether present or not, or NULL if the value would become a child of parent
+ConcurrentBinaryTreeNode *concurrent_binary_tree_find(ConcurrentBinaryTree *tree, int value,
+                                                      ConcurrentBinaryTreeNode **parent, int *direction,
+                                                      uint64_t *parent_version) {
+    retry:
+    *parent = tree->holder;
+    *direction = 1;
+
+    while (1) {
+        uint64_t before = atomic_load(&(*parent)->version);
+        ConcurrentBinaryTreeNode *child = atomic_load(&(*parent)->children[*direction]);
+        uint64_t after = atomic_load(&(*parent)->version);
+
+        // An unlinked node may have missed changes below its old place, so start over. Other changes only need the
+        // link to be read again
+        if (after & CONCURRENT_BINARY_TREE_UNLINKED) {
+            goto retry;
+        }
+        if (before != after) {
+            continue;
+        }
+
+        if (child == NULL || child->value == value) {
+            *parent_version = after;
+            return child;
+        }
+        *parent = child;
+        *direction = value > child->value;
+    }
+}
+
+/// Unlinks a node with at most one child, which takes its place. Both the node and its parent must be locked
+/// \param parent The parent of node
+/// \param direction The side of parent node is on
+/// \param node The node to unlink
+void concurrent_binary_tree_unlink(ConcurrentBinaryTreeNode *parent, int direction, ConcurrentBinaryTreeNode *node) {
+    ConcurrentBinaryTreeNode *child = atomic_load(&node->children[0]);
+    if (child == NULL) {
+        child = atomic_load(&node->children[1]);
+    }
+
+    // The unlinked bit has to be visible before the node disappears, so readers on it notice that they missed changes
+    atomic_fetch_or(&node->version, CONCURRENT_BINARY_TREE_UNLINKED);
+    if (child) {
+        atomic_store(&child->parent, parent);
+    }
+    atomic_store(&parent->children[direction], child);
+}
+
+/// Returns 1 if a node is absent and has at most one child, so it is of no use anymore
+int concurrent_binary_tree_is_removable(ConcurrentBinaryTreeNode *node) {
+    return !atomic_load(&node->present)
+           && (atomic_load(&node->children[0]) == NULL || atomic_load(&node->children[1]) == NULL);
+}
+
+/// Unlinks routing nodes which lost a child, starting at node and continuing with its ancestors
+/// \param tree The tree
+/// \param thread The handle of the calling thread
+/// \param node The parent of a node which was just unlinked
+void concurrent_binary_tree_clean_up(ConcurrentBinaryTree *tree, ConcurrentBinaryTreeThread *thread,
+                                     ConcurrentBinaryTreeNode *node) {
+    while (node != tree->holder && concurrent_binary_tree_is_removable(node)) {
+        ConcurrentBinaryTreeNode *parent = atomic_load(&node->parent);
+        int direction = parent == tree->holder || node->value > parent->value;
+
+        uint64_t parent_version = concurrent_binary_tree_lock(parent);
+        uint64_t version = concurrent_binary_tree_lock(node);
+        int linked = !((parent_version | version) & CONCURRENT_BINARY_TREE_UNLINKED)
+                     && atomic_load(&parent->children[direction]) == node;
+        int removable = linked && concurrent_binary_tree_is_removable(node);
+
+        if (removable) {
+            concurrent_binary_tree_unlink(parent, direction, node);
+        }
+        concurrent_binary_tree_unlock(node);
+        concurrent_binary_tree_unlock(parent);
+
+        if (removable) {
+            concurrent_binary_tree_retire(tree, thread, node);
+            node = parent;
+        } else if (!linked && (version & CONCURRENT_BINARY_TREE_UNLINKED)) {
+            return;
+        }
+        // If only the parent changed, its unlinking already moved node up, so try again with the new parent
+    }
+}
+
+/// Adds a value to the set
+/// \param tree The tree to insert into
+/// \param thread The handle of the calling thread
+/// \param value The value to insert
+/// \return 0 if insertion was successful, 1 if memory allocation failed and 2 if the value was already contained
+int concurrent_binary_tree_add(ConcurrentBinaryTree *tree, ConcurrentBinaryTreeThread *thread, int value) {
+    ConcurrentBinaryTreeNode *to_insert = concurrent_binary_tree_node_create(value);
+    if (to_insert == NULL) {
+        return 1;
+    }
+
+    int result;
+    concurrent_binary_tree_enter(tree, thread);
+    while (1) {
+        ConcurrentBinaryTreeNode *parent;
+        int direction;
+        uint64_t version;
+        ConcurrentBinaryTreeNode *node = concurrent_binary_tree_find(tree, value, &parent, &direction, &version);
+
+        if (node == NULL) {
+            if (!concurrent_binary_tree_try_lock(parent, version)) {
+                sched_yield();
+                continue;
+            }
+            atomic_store_explicit(&to_insert->parent, parent, memory_order_relaxed);
+            atomic_store(&parent->children[direction], to_insert);
+            concurrent_binary_tree_unlock(parent);
+            to_insert = NULL;
+            result = 0;
+            break;
+        }
+
+        // The value is still present if the node was linked when present was read
+        if (atomic_load(&node->present) && !concurrent_binary_tree_is_unlinked(node)) {
+            result = 2;
+            break;
+        }
+
+        // Revive a routing node
+        uint64_t node_version = concurrent_binary_tree_lock(node);
+        if (node_version & CONCURRENT_BINARY_TREE_UNLINKED) {
+            concurrent_binary_tree_unlock(node);
+            continue;
+        }
+        result = atomic_load(&node->present) ? 2 : 0;
+        atomic_store(&node->present, 1);
+        concurrent_binary_tree_unlock(node);
+        break;
+    }
+    concurrent_binary_tree_exit(thread);
+
+    free(to_insert);
+    return result;
+}
+
+/// Removes a value from the set
+/// \param tree The tree to remove from
+/// \param thread The handle of the calling thread
+/// \param value The value to remove
+/// \return 0 if the value was removed, else 1 if the tree doesn't contain that value
+int concurrent_binary_tree_remove(ConcurrentBinaryTree *tree, ConcurrentBinaryTreeThread *thread, int value) {
+    int result;
+    concurrent_binary_tree_enter(tree, thread);
+    while (1) {
+        ConcurrentBinaryTreeNode *parent;
+        int direction;
+        uint64_t version;
+        ConcurrentBinaryTreeNode *node = concurrent_binary_tree_find(tree, value, &parent, &direction, &version);
+
+        if (node == NULL || (!atomic_load(&node->present) && !concurrent_binary_tree_is_unlinked(node))) {
+            result = 1;
+            break;
+        }
+
+        // A node with two children only becomes a routing node, which needs no other lock
+        if (atomic_load(&node->children[0]) && atomic_load(&node->children[1])) {
+            uint64_t node_version = concurrent_binary_tree_lock(node);
+            int valid = !(node_version & CONCURRENT_BINARY_TREE_UNLINKED)
+                        && atomic_load(&node->children[0]) && atomic_load(&node->children[1]);
+            if (valid) {
+                result = atomic_load(&node->present) ? 0 : 1;
+                atomic_store(&node->present, 0);
+            }
+            concurrent_binary_tree_unlock(node);
+            if (valid) {
+                break;
+            }
+            continue;
+        }
+
+        // The parent still links to node as long as its version did not change, and node can only be unlinked by a
+        // thread holding the parent's lock
+        if (!concurrent_binary_tree_try_lock(parent, version)) {
+            sched_yield();
+            continue;
+        }
+        concurrent_binary_tree_lock(node);
+
+        int unlinked = 0;
+        if (!atomic_load(&node->present)) {
+            result = 1;
+        } else if (atomic_load(&node->children[0]) && atomic_load(&node->children[1])) {
+            result = -1;
+        } else {
+            atomic_store(&node->present, 0);
+            concurrent_binary_tree_unlink(parent, direction, node);
+            unlinked = 1;
+            result = 0;
+        }
+        concurrent_binary_tree_unlock(node);
+        concurrent_binary_tree_unlock(parent);
+
+        if (unlinked) {
+            concurrent_binary_tree_retire(tree, thread, node);
+            concurrent_binary_tree_clean_up(tree, thread, parent);
+        }
+        if (result != -1) {
+            break;
+        }
+    }
+    concurrent_binary_tree_exit(thread);
+    return result;
+}
+
+/// Returns 1 if the set contains a specified value. This never writes to the tree and never waits for locks
+/// \param tree The tree to search in
+/// \param thread The handle of the calling thread
+/// \param value The value to search for
+/// \return 1 if the tree contains that value, else 0
+int concurrent_binary_tree_contains(ConcurrentBinaryTree *tree, ConcurrentBinaryTreeThread *thread, int value) {
+    int result;
+    concurrent_binary_tree_enter(tree, thread);
+    while (1) {
+        ConcurrentBinaryTreeNode *parent;
+        int direction;
+        uint64_t version;
+        ConcurrentBinaryTreeNode *node = concurrent_binary_tree_find(tree, value, &parent, &direction, &version);
+
+        if (node == NULL) {
+            result = 0;
+            break;
+        }
+        result = atomic_load(&node->present);
+        if (!concurrent_binary_tree_is_unlinked(node)) {
+            break;
+        }
+    }
+    concurrent_binary_tree_exit(thread);
+    return result;
+}
+
+#endif
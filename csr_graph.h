@@ -0,0 +1,433 @@
+#ifndef CSR_GRAPH_H
+#define CSR_GRAPH_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+
+/*
+ * CSR GRAPH
+ *
+ * An immutable directed graph in compressed sparse row form. The nodes are numbered 0 to node_count - 1 and the
+ * successors of node i are targets[offsets[i]] to targets[offsets[i + 1] - 1], so all edges lie in one array ordered
+ * by their source. A traversal reads both arrays front to back instead of chasing a pointer per edge, and an edge takes
+ * four bytes instead of a list node.
+ *
+ * Every node keeps the value it had in the structure it was built from, so results can be mapped back.
+ * Adjacency lists are converted by adjacency_list_to_csr() next to their definitions.
+ *
+ * Offers breadth and depth first traversals, depth first numbering with edge classification, cycle detection and
+ * topological sorting, all in O(n + m) and without recursion, so deep graphs can't overflow the stack.
+ */
+
+
+/// Marks unreachable nodes in distance arrays and unnumbered nodes in depth first numberings
+#define CSR_GRAPH_UNREACHABLE UINT32_MAX
+
+// DATA STRUCTURES
+
+/// offsets has node_count + 1 entries, targets has edge_count entries and values has node_count entries
+typedef struct csr_graph {
+    size_t node_count;
+    size_t edge_count;
+    size_t *offsets;
+    uint32_t *targets;
+    int *values;
+} CsrGraph;
+
+/// The kinds of edges of a depth first search, see csr_graph_classify_edges()
+typedef enum {CSR_GRAPH_TREE_EDGE, CSR_GRAPH_FORWARD_EDGE, CSR_GRAPH_BACKWARD_EDGE, CSR_GRAPH_CROSS_EDGE} CsrGraphEdgeType;
+
+// CONSTRUCTORS AND DESTRUCTORS
+
+/// Destroys a graph
+/// \param graph The graph to destroy
+/// \return A NULL pointer to clean up the graph pointer
+CsrGraph *csr_graph_destroy(CsrGraph *graph) {
+    if (graph) {
+        free(graph->offsets);
+        free(graph->targets);
+        free(graph->values);
+    }
+    free(graph);
+    return NULL;
+}
+
+/// Creates a graph whose arrays still have to be filled. The offsets are all 0 and node i has the value i
+/// \param node_count The amount of nodes, which must be below UINT32_MAX
+/// \param edge_count The amount of edges
+/// \return A pointer to the graph or NULL in case of memory error or too many nodes
+CsrGraph *csr_graph_create(size_t node_count, size_t edge_count) {
+    if (node_count >= UINT32_MAX) {
+        return NULL;
+    }
+
+    CsrGraph *result = calloc(1, sizeof(CsrGraph));
+    if (result == NULL) {
+        perror("Could not allocate memory!");
+        return NULL;
+    }
+
+    result->node_count = node_count;
+    result->edge_count = edge_count;
+    result->offsets = calloc(node_count + 1, sizeof(size_t));
+    result->targets = malloc((edge_count ? edge_count : 1) * sizeof(uint32_t));
+    result->values = malloc((node_count ? node_count : 1) * sizeof(int));
+    if (result->offsets == NULL || result->targets == NULL || result->values == NULL) {
+        perror("Could not allocate memory!");
+        return csr_graph_destroy(result);
+    }
+
+    for (size_t i = 0; i < node_count; ++i) {
+        result->values[i] = (int) i;
+    }
+    return result;
+}
+
+/// Builds a graph from an edge list in O(n + m) by counting sort. The successors of a node keep the order in which
+/// their edges are given, duplicate edges are kept
+/// \param node_count The amount of nodes
+/// \param sources The source of every edge
+/// \param targets The target of every edge
+/// \param edge_count The amount of edges
+/// \return A pointer to the graph or NULL in case of memory error or if an edge refers to a node that doesn't exist
+CsrGraph *csr_graph_from_edges(size_t node_count, const uint32_t *sources, const uint32_t *targets,
+                               size_t edge_count) {
+    for (size_t i = 0; i < edge_count; ++i) {
+        if (sources[i] >= node_count || targets[i] >= node_count) {
+            return NULL;
+        }
+    }
+
+    CsrGraph *result = csr_graph_create(node_count, edge_count);
+    if (result == NULL) {
+        return NULL;
+    }
+
+    // Count the edges per node, shifted by one so the prefix sums become the start offsets
+    for (size_t i = 0; i < edge_count; ++i) {
+        ++result->offsets[sources[i] + 1];
+    }
+    for (size_t i = 0; i < node_count; ++i) {
+        result->offsets[i + 1] += result->offsets[i];
+    }
+
+    // Place every edge at the next free slot of its source. The slots are counted in offsets[source], which ends up
+    // one node too far and is shifted back afterwards
+    for (size_t i = 0; i < edge_count; ++i) {
+        result->targets[result->offsets[sources[i]]++] = targets[i];
+    }
+    memmove(result->offsets + 1, result->offsets, node_count * sizeof(size_t));
+    result->offsets[0] = 0;
+
+    return result;
+}
+
+// FUNCTIONS
+
+/// Returns the amount of successors of a node
+size_t csr_graph_degree(const CsrGraph *graph, uint32_t node) {
+    return graph->offsets[node + 1] - graph->offsets[node];
+}
+
+/// Returns the amount of bytes the graph occupies
+size_t csr_graph_memory(const CsrGraph *graph) {
+    return sizeof(CsrGraph) + (graph->node_count + 1) * sizeof(size_t) + graph->edge_count * sizeof(uint32_t)
+           + graph->node_count * sizeof(int);
+}
+
+/// Visits all nodes reachable from source in breadth first order
+/// \param graph The graph
+/// \param source The node to start from
+/// \param order Receives the reached nodes in the order they were visited, must have room for node_count nodes
+/// \param distances Receives the amount of edges on a shortest path to every node, CSR_GRAPH_UNREACHABLE for nodes
+/// which can't be reached. May be NULL
+/// \return The amount of reached nodes, 0 if source does not exist or memory allocation failed
+size_t csr_graph_breadth_first(const CsrGraph *graph, uint32_t source, uint32_t *order, uint32_t *distances) {
+    if (source >= graph->node_count) {
+        return 0;
+    }
+
+    // The distances double as visited marks, otherwise a private array is used
+    uint32_t *levels = distances ? distances : malloc(graph->node_count * sizeof(uint32_t));
+    if (levels == NULL) {
+        perror("Could not allocate memory!");
+        return 0;
+    }
+    for (size_t i = 0; i < graph->node_count; ++i) {
+        levels[i] = CSR_GRAPH_UNREACHABLE;
+    }
+
+    // order is the queue at the same time: everything before head was expanded, everything up to tail is queued
+    size_t head = 0, tail = 0;
+    order[tail++] = source;
+    levels[source] = 0;
+    while (head < tail) {
+        uint32_t node = order[head++];
+        for (size_t edge = graph->offsets[node]; edge < graph->offsets[node + 1]; ++edge) {
+            uint32_t target = graph->targets[edge];
+            if (levels[target] == CSR_GRAPH_UNREACHABLE) {
+                levels[target] = levels[node] + 1;
+                order[tail++] = target;
+            }
+        }
+    }
+
+    if (distances == NULL) {
+        free(levels);
+    }
+    return tail;
+}
+
+/// Visits all nodes reachable from source in depth first preorder, without recursion
+/// \param graph The graph
+/// \param source The node to start from
+/// \param order Receives the reached nodes in the order they were visited, must have room for node_count nodes
+/// \return The amount of reached nodes, 0 if source does not exist or memory allocation failed
+size_t csr_graph_depth_first(const CsrGraph *graph, uint32_t source, uint32_t *order) {
+    if (source >= graph->node_count) {
+        return 0;
+    }
+
+    // The stack holds the path to the current node together with the next edge to follow from every node on it
+    unsigned char *visited = calloc(graph->node_count, 1);
+    uint32_t *stack = malloc(graph->node_count * sizeof(uint32_t));
+    size_t *next_edge = malloc(graph->node_count * sizeof(size_t));
+    if (visited == NULL || stack == NULL || next_edge == NULL) {
+        perror("Could not allocate memory!");
+        free(visited);
+        free(stack);
+        free(next_edge);
+        return 0;
+    }
+
+    size_t count = 0, depth = 0;
+    visited[source] = 1;
+    order[count++] = source;
+    stack[depth] = source;
+    next_edge[depth++] = graph->offsets[source];
+
+    while (depth) {
+        uint32_t node = stack[depth - 1];
+        size_t edge = next_edge[depth - 1];
+
+        // Skip successors visited before
+        while (edge < graph->offsets[node + 1] && visited[graph->targets[edge]]) {
+            ++edge;
+        }
+        if (edge == graph->offsets[node + 1]) {
+            --depth;
+            continue;
+        }
+
+        uint32_t target = graph->targets[edge];
+        next_edge[depth - 1] = edge + 1;
+        visited[target] = 1;
+        order[count++] = target;
+        stack[depth] = target;
+        next_edge[depth++] = graph->offsets[target];
+    }
+
+    free(visited);
+    free(stack);
+    free(next_edge);
+    return count;
+}
+
+/// Numbers the nodes in depth first pre- and postorder and classifies every edge in one iterative pass in O(n + m).
+/// Searches start at every node not reached yet, in increasing order. For an edge from v to w, w is either reached by
+/// it (tree edge), a finished descendant of v (forward edge), on the search path (backward edge) or finished in another
+/// branch (cross edge). The graph is acyclic exactly if there is no backward edge
+/// \param graph The graph
+/// \param dfsnum Receives the preorder number of every node, must have room for node_count numbers
+/// \param compnum Receives the postorder number of every node, must have room for node_count numbers
+/// \param edge_types Receives a CsrGraphEdgeType for every edge in the order of targets, must have room for edge_count
+/// entries
+/// \return 0 on success, 1 in case of memory error
+int csr_graph_classify_edges(const CsrGraph *graph, uint32_t *dfsnum, uint32_t *compnum, unsigned char *edge_types) {
+    uint32_t *stack = malloc((graph->node_count ? graph->node_count : 1) * sizeof(uint32_t));
+    size_t *next_edge = malloc((graph->node_count ? graph->node_count : 1) * sizeof(size_t));
+    if (stack == NULL || next_edge == NULL) {
+        perror("Could not allocate memory!");
+        free(stack);
+        free(next_edge);
+        return 1;
+    }
+
+    // Unassigned numbers double as states: no dfsnum means not reached, no compnum means on the search path
+    for (size_t i = 0; i < graph->node_count; ++i) {
+        dfsnum[i] = CSR_GRAPH_UNREACHABLE;
+        compnum[i] = CSR_GRAPH_UNREACHABLE;
+    }
+
+    uint32_t preorder = 0, postorder = 0;
+    for (uint32_t start = 0; start < graph->node_count; ++start) {
+        if (dfsnum[start] != CSR_GRAPH_UNREACHABLE) {
+            continue;
+        }
+
+        size_t depth = 0;
+        dfsnum[start] = preorder++;
+        stack[depth] = start;
+        next_edge[depth++] = graph->offsets[start];
+
+        while (depth) {
+            uint32_t node = stack[depth - 1];
+            size_t edge = next_edge[depth - 1];
+            if (edge == graph->offsets[node + 1]) {
+                compnum[node] = postorder++;
+                --depth;
+                continue;
+            }
+
+            uint32_t target = graph->targets[edge];
+            next_edge[depth - 1] = edge + 1;
+            if (dfsnum[target] == CSR_GRAPH_UNREACHABLE) {
+                edge_types[edge] = CSR_GRAPH_TREE_EDGE;
+                dfsnum[target] = preorder++;
+                stack[depth] = target;
+                next_edge[depth++] = graph->offsets[target];
+            } else if (dfsnum[target] > dfsnum[node]) {
+                edge_types[edge] = CSR_GRAPH_FORWARD_EDGE;
+            } else if (compnum[target] == CSR_GRAPH_UNREACHABLE) {
+                edge_types[edge] = CSR_GRAPH_BACKWARD_EDGE;
+            } else {
+                edge_types[edge] = CSR_GRAPH_CROSS_EDGE;
+            }
+        }
+    }
+
+    free(stack);
+    free(next_edge);
+    return 0;
+}
+
+/// Finds a cycle with an iterative depth first search. A cycle is closed by the first edge back to a node which is
+/// still on the search path, and consists of the path from that node on
+/// \param graph The graph
+/// \param cycle Receives the nodes of the cycle in the order of its edges, must have room for node_count nodes
+/// \return The length of the cycle, 0 if the graph is acyclic or memory allocation failed
+size_t csr_graph_find_cycle(const CsrGraph *graph, uint32_t *cycle) {
+
+    // 0 for nodes not reached yet, 1 for nodes on the path and 2 for nodes whose successors were all searched
+    unsigned char *states = calloc(graph->node_count ? graph->node_count : 1, 1);
+    uint32_t *stack = malloc((graph->node_count ? graph->node_count : 1) * sizeof(uint32_t));
+    size_t *next_edge = malloc((graph->node_count ? graph->node_count : 1) * sizeof(size_t));
+    if (states == NULL || stack == NULL || next_edge == NULL) {
+        perror("Could not allocate memory!");
+        free(states);
+        free(stack);
+        free(next_edge);
+        return 0;
+    }
+
+    size_t length = 0;
+    for (uint32_t start = 0; start < graph->node_count && length == 0; ++start) {
+        if (states[start]) {
+            continue;
+        }
+
+        size_t depth = 0;
+        states[start] = 1;
+        stack[depth] = start;
+        next_edge[depth++] = graph->offsets[start];
+
+        while (depth && length == 0) {
+            uint32_t node = stack[depth - 1];
+            size_t edge = next_edge[depth - 1];
+            while (edge < graph->offsets[node + 1] && states[graph->targets[edge]] == 2) {
+                ++edge;
+            }
+            if (edge == graph->offsets[node + 1]) {
+                states[node] = 2;
+                --depth;
+                continue;
+            }
+
+            uint32_t target = graph->targets[edge];
+            next_edge[depth - 1] = edge + 1;
+            if (states[target] == 1) {
+                size_t begin = depth - 1;
+                while (stack[begin] != target) {
+                    --begin;
+                }
+                length = depth - begin;
+                memcpy(cycle, stack + begin, length * sizeof(uint32_t));
+            } else {
+                states[target] = 1;
+                stack[depth] = target;
+                next_edge[depth++] = graph->offsets[target];
+            }
+        }
+    }
+
+    free(states);
+    free(stack);
+    free(next_edge);
+    return length;
+}
+
+/// Sorts the nodes topologically with Kahn's algorithm in O(n + m): nodes without remaining predecessors are queued,
+/// and taking one from the queue decrements the in-degrees of its successors. The graph is not changed
+/// \param graph The graph
+/// \param order Receives the nodes so that every edge points to a later node, must have room for node_count nodes.
+/// Only complete if the graph is acyclic
+/// \param cycle Receives the nodes of one cycle if the graph is cyclic, must have room for node_count nodes. May be
+/// NULL
+/// \param cycle_length Receives the length of the cycle, 0 for acyclic graphs. May be NULL if cycle is NULL
+/// \return 0 if the graph is acyclic, 1 in case of memory error and 2 if the graph contains a cycle
+int csr_graph_topological_sort(const CsrGraph *graph, uint32_t *order, uint32_t *cycle, size_t *cycle_length) {
+    size_t *in_degrees = calloc(graph->node_count ? graph->node_count : 1, sizeof(size_t));
+    if (in_degrees == NULL) {
+        perror("Could not allocate memory!");
+        return 1;
+    }
+    for (size_t edge = 0; edge < graph->edge_count; ++edge) {
+        ++in_degrees[graph->targets[edge]];
+    }
+
+    // order is the queue at the same time, like in csr_graph_breadth_first()
+    size_t head = 0, tail = 0;
+    for (uint32_t node = 0; node < graph->node_count; ++node) {
+        if (in_degrees[node] == 0) {
+            order[tail++] = node;
+        }
+    }
+    while (head < tail) {
+        uint32_t node = order[head++];
+        for (size_t edge = graph->offsets[node]; edge < graph->offsets[node + 1]; ++edge) {
+            if (--in_degrees[graph->targets[edge]] == 0) {
+                order[tail++] = graph->targets[edge];
+            }
+        }
+    }
+    free(in_degrees);
+
+    if (cycle_length) {
+        *cycle_length = 0;
+    }
+    if (tail == graph->node_count) {
+        return 0;
+    }
+
+    if (cycle) {
+        *cycle_length = csr_graph_find_cycle(graph, cycle);
+        if (*cycle_length == 0) {
+            return 1;
+        }
+    }
+    return 2;
+}
+
+void csr_graph_print(const CsrGraph *graph) {
+    for (size_t i = 0; i < graph->node_count; ++i) {
+        printf("%d:", graph->values[i]);
+        for (size_t edge = graph->offsets[i]; edge < graph->offsets[i + 1]; ++edge) {
+            printf(" %d", graph->values[graph->targets[edge]]);
+        }
+        printf("\n");
+    }
+}
+
+#endif
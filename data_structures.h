@@ -4,77 +4,101 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <assert.h>
+#include <string.h>
+#include <stdint.h>
+#include "memory_pool.h"
+#include "generic.h"
+#include "simd.h"
+#include "csr_graph.h"
 
 /*
  * Contains:
  *
  * - Linked List
+ * - Unrolled Linked List
+ * - Skip List
  * - Integer Array
  * - Tree
  * - Binary Tree
+ * - Binary Tree Snapshot
+ * - Compact Binary Tree
  * - B-Tree
  * - Hash Table
  */
 
 
-/* ### LINKED LIST ### */
+/* ### LINKED LIST ###
+ *
+ * An integer instantiation of the generic linked list, see generic.h for the generated linked_list_* functions
+ */
+
+
+GENERATE_LINKED_LIST(LinkedList, linked_list, int, GENERIC_COMPARE, "%d ")
+
+
+/* ### UNROLLED LINKED LIST ###
+ *
+ * Offers the same operations as Linked List, but every node stores a small array of values instead of a single one.
+ * A node spans two cache lines, so scanning the list takes one cache miss per UNROLLED_LINKED_LIST_CAPACITY values
+ * instead of one per value. Splitting on insertion and refilling on removal keep every node but the tail at least half
+ * full.
+ *
+ */
+
 
+#define UNROLLED_LINKED_LIST_CAPACITY 28
 
 // DATA STRUCTURES
 
-typedef struct linked_list_node LinkedListNode;
+typedef struct unrolled_linked_list_node UnrolledLinkedListNode;
 
-struct linked_list_node {
-    int value;
-    LinkedListNode *next;
+/// The values of a node are kept in order in values[0] to values[count - 1]
+struct unrolled_linked_list_node {
+    UnrolledLinkedListNode *next;
+    size_t count;
+    int values[UNROLLED_LINKED_LIST_CAPACITY];
 };
 
-/// Linked list is just a wrapper for the nodes
-typedef struct linked_list {
-    LinkedListNode *head;
-} LinkedList;
+typedef struct unrolled_linked_list {
+    UnrolledLinkedListNode *head;
+    UnrolledLinkedListNode *tail;
+    size_t length;
+} UnrolledLinkedList;
 
 // CONSTRUCTORS AND DESTRUCTORS
 
-/// Creates a new linked list node
-/// \param value The node's value
+/// Creates a new empty unrolled linked list node
 /// \return A pointer to the new node or NULL if memory allocation failed
-LinkedListNode *linked_list_node_create(int value) {
-    LinkedListNode *result = malloc(sizeof(LinkedListNode));
+UnrolledLinkedListNode *unrolled_linked_list_node_create() {
+    UnrolledLinkedListNode *result = malloc(sizeof(UnrolledLinkedListNode));
     if (result == NULL) {
         perror("Could not allocate memory!");
         return NULL;
     }
 
-    result->value = value;
     result->next = NULL;
+    result->count = 0;
 
     return result;
 }
 
-/// Destroys all linked nodes starting at node. This is usually the root of a linked list
-/// \param linkedlistnode The node to destroy
-/// \return A NULL pointer to be used for overwriting the object pointer
-LinkedListNode *linked_list_node_destroy_recursively(LinkedListNode *node) {
-    if (node) {
-        node->next = linked_list_node_destroy_recursively(node->next);
-    }
-    free(node);
-    return NULL;
-}
-
-/// Creates a linked list
+/// Creates an unrolled linked list
 /// \return A pointer to the list or NULL if memory allocation failed
-LinkedList *linked_list_create() {
-    return calloc(1, sizeof(LinkedList));
+UnrolledLinkedList *unrolled_linked_list_create() {
+    return calloc(1, sizeof(UnrolledLinkedList));
 }
 
 /// Destroys the given list, freeing its memory
 /// \param list The list to destroy
 /// \return A NULL pointer to be used for overwriting the object pointer
-LinkedList *linked_list_destroy(LinkedList *list) {
+UnrolledLinkedList *unrolled_linked_list_destroy(UnrolledLinkedList *list) {
     if (list) {
-        list->head = linked_list_node_destroy_recursively(list->head);
+        UnrolledLinkedListNode *current = list->head;
+        while (current) {
+            UnrolledLinkedListNode *next = current->next;
+            free(current);
+            current = next;
+        }
     }
     free(list);
     return NULL;
@@ -82,19 +106,72 @@ LinkedList *linked_list_destroy(LinkedList *list) {
 
 // FUNCTIONS
 
-/// Calculates the length of the linked list dynamically
+/// Returns the length of the list, which is maintained by all the list operations
 /// \param list The target list
 /// \return The length
-size_t linked_list_get_length(LinkedList *list) {
-    LinkedListNode *head = list->head;
-    size_t result = 0;
+size_t unrolled_linked_list_get_length(UnrolledLinkedList *list) {
+    return list->length;
+}
+
+/// Inserts a value at a given offset into a node. A full node is split in half first, unless the value goes to its end
+/// and can be put in front of the next node or into a fresh tail node instead
+/// \param list The list the node belongs to
+/// \param node The target node or NULL if the list is empty
+/// \param offset The index inside the node, at most node->count
+/// \param value The value to insert
+/// \return 0 if insertion was successful and 1 if memory allocation failed
+int unrolled_linked_list_node_insert(UnrolledLinkedList *list, UnrolledLinkedListNode *node, size_t offset,
+                                     int value) {
+
+    // Catch empty list case
+    if (node == NULL) {
+        node = unrolled_linked_list_node_create();
+        if (node == NULL) {
+            return 1;
+        }
+        list->head = node;
+        list->tail = node;
+        offset = 0;
+    } else if (node->count == UNROLLED_LINKED_LIST_CAPACITY) {
+        if (offset == node->count && node->next && node->next->count < UNROLLED_LINKED_LIST_CAPACITY) {
+            node = node->next;
+            offset = 0;
+        } else {
+            UnrolledLinkedListNode *successor = unrolled_linked_list_node_create();
+            if (successor == NULL) {
+                return 1;
+            }
+
+            successor->next = node->next;
+            node->next = successor;
+            if (list->tail == node) {
+                list->tail = successor;
+            }
 
-    while (head != NULL) {
-        head = head->next;
-        ++result;
+            // Appending to the tail starts a fresh node, so lists built by appending have full nodes.
+            // Else the upper half moves to the successor
+            if (offset == node->count && successor == list->tail) {
+                node = successor;
+                offset = 0;
+            } else {
+                size_t half = node->count / 2;
+                successor->count = node->count - half;
+                memcpy(successor->values, node->values + half, successor->count * sizeof(int));
+                node->count = half;
+
+                if (offset > half) {
+                    offset -= half;
+                    node = successor;
+                }
+            }
+        }
     }
 
-    return result;
+    memmove(node->values + offset + 1, node->values + offset, (node->count - offset) * sizeof(int));
+    node->values[offset] = value;
+    ++node->count;
+    ++list->length;
+    return 0;
 }
 
 /// Inserts a value at a given index
@@ -102,105 +179,85 @@ size_t linked_list_get_length(LinkedList *list) {
 /// \param value The value to insert
 /// \param index The index at which the insertion takes place
 /// \return 0 if insertion was successful, 2 if index was out of range and 1 if memory allocation failed
-int linked_list_insert(LinkedList *list, int value, size_t index) {
+int unrolled_linked_list_insert(UnrolledLinkedList *list, int value, size_t index) {
 
     // Catch index out of range
-    if (index > linked_list_get_length(list)) {
+    if (index > list->length) {
         perror("List index out of range!");
         return 2;
     }
 
-    LinkedListNode *head = list->head;
-    LinkedListNode *to_insert = linked_list_node_create(value);
-    if (to_insert == NULL) {
-        return 1;
+    // Catch append to end case, which needs no traversal thanks to the tail
+    if (index == list->length) {
+        return unrolled_linked_list_node_insert(list, list->tail, list->tail ? list->tail->count : 0, value);
     }
 
-    // Catch append to front case
-    // Else insert normally
-    if (index == 0) {
-        to_insert->next = head;
-        list->head = to_insert;
-    } else {
-        LinkedListNode *before = head;
+    // Skip whole nodes until the index falls into one
+    UnrolledLinkedListNode *node = list->head;
+    while (index >= node->count) {
+        index -= node->count;
+        node = node->next;
+    }
 
-        for (size_t i = 0; i < index; ++i) {
-            before = head;
-            head = head->next;
-        }
+    return unrolled_linked_list_node_insert(list, node, index, value);
+}
 
-        before->next = to_insert;
-        to_insert->next = head;
-    }
-    return 0;
+/// Wrapper for unrolled_linked_list_insert() to append a value to the end in constant time
+/// \param list The target list
+/// \param value The value to append
+void unrolled_linked_list_add(UnrolledLinkedList *list, int value) {
+    unrolled_linked_list_insert(list, value, list->length);
 }
 
-/// Assumes that the Linked List is already sorted and inserts at the first fitting place
+/// Assumes that the list is already sorted and inserts after all values which are smaller or equal
 /// \param list The list to insert into
 /// \param value The value to insert
 /// \return 0 if insertion was successful and 1 if memory allocation failed
-int linked_list_add_sorted(LinkedList *list, int value) {
+int unrolled_linked_list_add_sorted(UnrolledLinkedList *list, int value) {
+    UnrolledLinkedListNode *node = list->head;
 
-    LinkedListNode *to_insert = linked_list_node_create(value);
-    if (to_insert == NULL) {
-        return 1;
+    // Catch empty list and append to end case
+    if (node == NULL || list->tail->values[list->tail->count - 1] <= value) {
+        return unrolled_linked_list_node_insert(list, list->tail, list->tail ? list->tail->count : 0, value);
     }
 
-    LinkedListNode *current_node = list->head;
-
-    // Catch empty list and append to front case
-    if (current_node == NULL || current_node->value > value) {
-        to_insert->next = current_node;
-        list->head = to_insert;
-    } else {
-        LinkedListNode *precursor = NULL;
-
-        for (size_t i = 0; i < linked_list_get_length(list); ++i) {
-
-            precursor = current_node;
-            current_node = current_node->next;
+    // Skip all nodes whose values are all smaller or equal. The tail is larger, so we stop before the end
+    while (node->values[node->count - 1] <= value) {
+        node = node->next;
+    }
 
-            // current node is NULL? Then we are at the end and the value to insert is the largest in the list
-            // or is the current value larger than our value? then we can insert too
-            if (current_node == NULL || current_node->value > value) {
-                to_insert->next = current_node;
-                precursor->next = to_insert;
-                break;
-            }
-            // if not, move further in the list
+    // Binary search for the first larger value inside the node
+    size_t lower_bound = 0;
+    size_t upper_bound = node->count - 1;
+    while (lower_bound < upper_bound) {
+        size_t middle = lower_bound + (upper_bound - lower_bound) / 2;
+        if (node->values[middle] <= value) {
+            lower_bound = middle + 1;
+        } else {
+            upper_bound = middle;
         }
     }
-    return 0;
+
+    return unrolled_linked_list_node_insert(list, node, lower_bound, value);
 }
 
-/// Turns a linked list into an array
+/// Turns an unrolled linked list into an array
 /// \param list The list
-/// \param array The array to hold the list values
-void linked_list_as_array(LinkedList *list, int *array) {
-
-    LinkedListNode *node = list->head;
-
-    for (size_t i = 0; i < linked_list_get_length(list); ++i) {
-        array[i] = node->value;
-        node = node->next;
+/// \param array The array to hold the list values, which must fit at least list->length values
+void unrolled_linked_list_as_array(UnrolledLinkedList *list, int *array) {
+    for (UnrolledLinkedListNode *node = list->head; node; node = node->next) {
+        memcpy(array, node->values, node->count * sizeof(int));
+        array += node->count;
     }
 }
 
-/// Wrapper for insert_at_linked_list() to append a value to the end
-/// \param list The target list
-/// \param value The value to append
-void linked_list_add(LinkedList *list, int value) {
-    linked_list_insert(list, value, linked_list_get_length(list));
-}
-
-/// Prints the linked list as a one line blank delimited string
+/// Prints the list as a one line blank delimited string
 /// \param list The list to print
-void linked_list_print(LinkedList *list) {
-    LinkedListNode *head = list->head;
-
-    while (head != NULL) {
-        printf("%d ", head->value);
-        head = head->next;
+void unrolled_linked_list_print(UnrolledLinkedList *list) {
+    for (UnrolledLinkedListNode *node = list->head; node; node = node->next) {
+        for (size_t i = 0; i < node->count; ++i) {
+            printf("%d ", node->values[i]);
+        }
     }
 
     printf("\n");
@@ -210,201 +267,719 @@ void linked_list_print(LinkedList *list) {
 /// \param list The list to search in
 /// \param value The value to search for
 /// \return 1 if the list contains that value, else 0
-int linked_list_contains(LinkedList *list, int value) {
-    LinkedListNode *current = list->head;
-    while (current) {
-        if (current->value == value) {
+int unrolled_linked_list_contains(UnrolledLinkedList *list, int value) {
+    for (UnrolledLinkedListNode *node = list->head; node; node = node->next) {
+
+        // Compare the whole node without branching, which lets the compiler vectorize the loop
+        int found = 0;
+        for (size_t i = 0; i < node->count; ++i) {
+            found |= node->values[i] == value;
+        }
+        if (found) {
             return 1;
         }
-        current = current->next;
     }
     return 0;
 }
 
+/// Refills a node which dropped below half of its capacity from its successor. The successor is merged into the node
+/// if both fit into one, else values are moved over until both are at least half full
+/// \param list The list the node belongs to
+/// \param node The node, which must have a successor
+void unrolled_linked_list_node_refill(UnrolledLinkedList *list, UnrolledLinkedListNode *node) {
+    UnrolledLinkedListNode *next = node->next;
+
+    if (node->count + next->count <= UNROLLED_LINKED_LIST_CAPACITY) {
+        memcpy(node->values + node->count, next->values, next->count * sizeof(int));
+        node->count += next->count;
+        node->next = next->next;
+        if (next == list->tail) {
+            list->tail = node;
+        }
+        free(next);
+    } else {
+        size_t moved = (next->count - node->count) / 2;
+        memcpy(node->values + node->count, next->values, moved * sizeof(int));
+        memmove(next->values, next->values + moved, (next->count - moved) * sizeof(int));
+        node->count += moved;
+        next->count -= moved;
+    }
+}
 
-/* ### INTEGER ARRAY ###
+/// Removes the first occurrence of a specified value. A node dropping below half of its capacity is refilled from its
+/// successor, so every node but the tail stays at least half full. An empty tail is unlinked
+/// \param list The list to remove from
+/// \param value The value to remove
+/// \return 0 if a value was removed, else 1 if the list doesn't contain that value
+int unrolled_linked_list_remove(UnrolledLinkedList *list, int value) {
+    UnrolledLinkedListNode *node = list->head;
+    UnrolledLinkedListNode *last = NULL;
+
+    while (node) {
+        for (size_t i = 0; i < node->count; ++i) {
+            if (node->values[i] == value) {
+                memmove(node->values + i, node->values + i + 1, (node->count - i - 1) * sizeof(int));
+                --node->count;
+                --list->length;
+
+                if (node->count < UNROLLED_LINKED_LIST_CAPACITY / 2 && node->next) {
+                    unrolled_linked_list_node_refill(list, node);
+                } else if (node->count == 0) {
+                    if (last == NULL) {
+                        list->head = node->next;
+                    } else {
+                        last->next = node->next;
+                    }
+
+                    // Removing the last node makes its precursor the new tail
+                    if (node == list->tail) {
+                        list->tail = last;
+                    }
+
+                    free(node);
+                }
+                return 0;
+            }
+        }
+        last = node;
+        node = node->next;
+    }
+    return 1;
+}
+
+
+/* ### SKIP LIST ###
  *
- * This is a wrapper which keeps track of the array length
+ * A sorted list with the same operations as a sorted Linked List, but insertion, removal and lookup take expected
+ * logarithmic time. Every node is linked on a random number of levels, where each level skips over roughly twice as
+ * many nodes as the one below. The level is drawn from a seeded splitmix64 generator instead of rand(), which is both
+ * faster and makes the shape of the list reproducible.
  *
  */
 
 
+#define SKIP_LIST_MAX_LEVEL 32
+
 // DATA STRUCTURES
 
-typedef struct integer_array {
+typedef struct skip_list_node SkipListNode;
+
+/// next[0] links all nodes in order, the higher levels link a subset of them
+struct skip_list_node {
+    int value;
+    size_t level;
+    SkipListNode *next[];
+};
+
+/// The head is a sentinel node linked on all levels. level is the highest level currently in use
+typedef struct skip_list {
+    SkipListNode *head;
+    size_t level;
     size_t length;
-    int *elements;
-} IntegerArray;
+    uint64_t random_state;
+} SkipList;
 
 // CONSTRUCTORS AND DESTRUCTORS
 
-/// Destroy an integer array
-/// \param integerArray The integer array
-/// \return NULL
-IntegerArray *destroy_integer_array(IntegerArray *integerArray) {
-    if (integerArray) {
-        free(integerArray->elements);
-        free(integerArray);
-    }
-    return NULL;
-}
-
-/// Creates a new integer array of given length
-/// \param length The length of thr array
-/// \return A pointer to the given array or NULL in case of a memory allocation failure
-IntegerArray *create_integer_array(size_t length) {
-    IntegerArray *result = malloc(sizeof(IntegerArray));
+/// Creates a new skip list node linked on the given amount of levels
+/// \param value The node's value
+/// \param level The amount of levels, at least 1
+/// \return A pointer to the new node or NULL if memory allocation failed
+SkipListNode *skip_list_node_create(int value, size_t level) {
+    SkipListNode *result = malloc(sizeof(SkipListNode) + level * sizeof(SkipListNode *));
     if (result == NULL) {
+        perror("Could not allocate memory!");
         return NULL;
     }
 
-    result->elements = calloc(length, sizeof(int));
-    if (result->elements == NULL) {
-        return destroy_integer_array(result);
+    result->value = value;
+    result->level = level;
+    for (size_t i = 0; i < level; ++i) {
+        result->next[i] = NULL;
     }
 
-    result->length = length;
-
     return result;
 }
 
-/// Prints the integer array as a one line comma delimited string
-/// \param integerArray The array to print
-void print_integer_array(IntegerArray *integerArray) {
-    printf("[");
-    for (size_t i = 0; i < integerArray->length; ++i) {
-        printf("%d", integerArray->elements[i]);
-        if (i != integerArray->length - 1) {
-            printf(", ");
+/// Destroys the given list, freeing its memory
+/// \param list The list to destroy
+/// \return A NULL pointer to be used for overwriting the object pointer
+SkipList *skip_list_destroy(SkipList *list) {
+    if (list) {
+        SkipListNode *current = list->head;
+        while (current) {
+            SkipListNode *next = current->next[0];
+            free(current);
+            current = next;
         }
     }
-    printf("]\n");
+    free(list);
+    return NULL;
 }
 
+/// Creates an empty skip list
+/// \param seed The seed for the level generator. Lists with equal seeds and equal operations have equal shapes
+/// \return A pointer to the list or NULL if memory allocation failed
+SkipList *skip_list_create(uint64_t seed) {
+    SkipList *result = malloc(sizeof(SkipList));
+    if (result == NULL) {
+        return NULL;
+    }
 
-/* ### TREE ### */
+    result->head = skip_list_node_create(0, SKIP_LIST_MAX_LEVEL);
+    if (result->head == NULL) {
+        free(result);
+        return NULL;
+    }
 
+    result->level = 1;
+    result->length = 0;
+    result->random_state = seed;
 
-// DATA STRUCTURES
+    return result;
+}
 
-typedef struct tree_node TreeNode;
+// FUNCTIONS
 
-typedef struct tree_node_array {
-    size_t length;
-    TreeNode **elements;
-} TreeNodeArray;
+/// Advances a splitmix64 generator. Every state, including 0, is a valid seed
+/// \param state The generator state, which is updated
+/// \return The next pseudo random number
+uint64_t splitmix64_next(uint64_t *state) {
+    uint64_t result = (*state += 0x9E3779B97F4A7C15ULL);
+    result = (result ^ (result >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    result = (result ^ (result >> 27)) * 0x94D049BB133111EBULL;
+    return result ^ (result >> 31);
+}
 
-struct tree_node {
-    size_t degree;
-    size_t last_key_index;
-    TreeNodeArray *children;
-    IntegerArray *keys;
-};
+/// Draws the level for a new node, where level k + 1 is half as likely as level k
+/// \param list The list whose generator is used
+/// \return A level between 1 and SKIP_LIST_MAX_LEVEL
+size_t skip_list_random_level(SkipList *list) {
+    uint64_t bits = splitmix64_next(&list->random_state);
+    size_t level = 1;
 
-typedef struct tree {
-    TreeNode *root;
-    size_t degree;
-} Tree;
+    while ((bits & 1) && level < SKIP_LIST_MAX_LEVEL) {
+        bits >>= 1;
+        ++level;
+    }
 
-// CONSTRUCTORS AND DESTRUCTORS
+    return level;
+}
 
-/// Destroy a given node array
-/// \param nodeArray The node array to destroy
-/// \return NULL
-TreeNodeArray *destroy_node_array(TreeNodeArray *nodeArray) {
-    if (nodeArray) {
-        free(nodeArray->elements);
-    }
-    free(nodeArray);
-    return NULL;
+/// Returns the number of values in the list
+/// \param list The target list
+/// \return The length
+size_t skip_list_get_length(SkipList *list) {
+    return list->length;
 }
 
-/// Creates an array of nodes with a given length
-/// \param length The length of the array
-/// \return A pointer to the new array or NULL if memory allocation failed
-TreeNodeArray *create_node_array(size_t length) {
-    TreeNodeArray *result = malloc(sizeof(TreeNodeArray));
-    if (result == NULL) {
-        return NULL;
+/// Inserts a value after all values which are smaller or equal
+/// \param list The list to insert into
+/// \param value The value to insert
+/// \return 0 if insertion was successful and 1 if memory allocation failed
+int skip_list_add_sorted(SkipList *list, int value) {
+    SkipListNode *update[SKIP_LIST_MAX_LEVEL];
+    SkipListNode *node = list->head;
+
+    // On every level, remember the last node which stays in front of the new one
+    for (size_t i = list->level; i-- > 0;) {
+        while (node->next[i] && node->next[i]->value <= value) {
+            node = node->next[i];
+        }
+        update[i] = node;
     }
 
-    result->elements = calloc(length, sizeof(TreeNode));
-    if (result->elements == NULL) {
-        return destroy_node_array(result);
+    size_t level = skip_list_random_level(list);
+    SkipListNode *to_insert = skip_list_node_create(value, level);
+    if (to_insert == NULL) {
+        return 1;
     }
 
-    result->length = length;
+    // Levels which were unused so far start at the head
+    for (size_t i = list->level; i < level; ++i) {
+        update[i] = list->head;
+    }
+    if (level > list->level) {
+        list->level = level;
+    }
 
-    return result;
+    for (size_t i = 0; i < level; ++i) {
+        to_insert->next[i] = update[i]->next[i];
+        update[i]->next[i] = to_insert;
+    }
+
+    ++list->length;
+    return 0;
 }
 
-/// Destroys a node and its child nodes recursively
-/// \param node The node to destroy
-/// \return A NULL pointer to clean up the node pointer
-TreeNode *destroy_tree_nodes_recursively(TreeNode *node) {
-    if (node) {
-        node->keys = destroy_integer_array(node->keys);
-        node->children = destroy_node_array(node->children);
+/// Finds the first node whose value is not smaller than value
+/// \param list The list to search in
+/// \param value The value to search for
+/// \return A pointer to the node or NULL if all values are smaller
+SkipListNode *skip_list_seek(SkipList *list, int value) {
+    SkipListNode *node = list->head;
+
+    for (size_t i = list->level; i-- > 0;) {
+        while (node->next[i] && node->next[i]->value < value) {
+            node = node->next[i];
+        }
     }
-    free(node);
-    return NULL;
+
+    return node->next[0];
 }
 
-/// Creates a new node of given degree
-/// \param degree The degree of the node
-/// \return A pointer to the new node or NULL in case of memory allocation failure
-TreeNode *create_tree_node(size_t degree) {
+/// Returns 1 if the list contains a specified value
+/// \param list The list to search in
+/// \param value The value to search for
+/// \return 1 if the list contains that value, else 0
+int skip_list_contains(SkipList *list, int value) {
+    SkipListNode *node = skip_list_seek(list, value);
+    return node && node->value == value;
+}
 
-    TreeNode *result = malloc(sizeof(TreeNode));
-    if (result == NULL) {
-        return NULL;
+/// Removes one node holding a specified value
+/// \param list The list to remove from
+/// \param value The value to remove
+/// \return 0 if a node was removed, else 1 if the list doesn't contain that value
+int skip_list_remove(SkipList *list, int value) {
+    SkipListNode *update[SKIP_LIST_MAX_LEVEL];
+    SkipListNode *node = list->head;
+
+    for (size_t i = list->level; i-- > 0;) {
+        while (node->next[i] && node->next[i]->value < value) {
+            node = node->next[i];
+        }
+        update[i] = node;
     }
 
-    result->keys = create_integer_array(degree - 1);
-    result->children = create_node_array(degree);
-    if (result->keys == NULL || result->children == NULL) {
-        return destroy_tree_nodes_recursively(result);
+    SkipListNode *target = node->next[0];
+    if (target == NULL || target->value != value) {
+        return 1;
     }
 
-    result->degree = degree;
-    result->last_key_index = 0;
-
-    return result;
-}
-
-/// Creates a new n-ary tree
-/// \param degree The degree
-/// \return A pointer to the new tree or NULL in case of memory error or if the degree is invalid (lower than 2)
-Tree *create_tree(size_t degree) {
-    if (degree < 2) {
-        return NULL;
+    for (size_t i = 0; i < target->level; ++i) {
+        update[i]->next[i] = target->next[i];
     }
+    free(target);
 
-    Tree *result = malloc(sizeof(Tree));
-    if (result == NULL) {
-        return NULL;
+    // Drop levels which became empty
+    while (list->level > 1 && list->head->next[list->level - 1] == NULL) {
+        --list->level;
     }
 
-    result->root = NULL;
-    result->degree = degree;
-    return result;
+    --list->length;
+    return 0;
 }
 
-/// Destroys the tree, recursively destroying its nodes
-/// \param tree The tree to destroy
-/// \return A NULL pointer to clean up the tree pointer
-Tree *destroy_tree(Tree *tree) {
-    if (tree) {
-        tree->root = destroy_tree_nodes_recursively(tree->root);
-    }
-    free(tree);
-    return NULL;
+/// Returns the node with the smallest value, which starts an ordered iteration using skip_list_next()
+/// \param list The list to iterate
+/// \return A pointer to the first node or NULL if the list is empty
+SkipListNode *skip_list_begin(SkipList *list) {
+    return list->head->next[0];
 }
 
-// FUNCTIONS
+/// Returns the node following node in ascending order
+/// \param node The current node
+/// \return A pointer to the next node or NULL if node was the last one
+SkipListNode *skip_list_next(SkipListNode *node) {
+    return node->next[0];
+}
 
-/// Prints tree_node keys, also showing how many of the key slots are still unset
-/// \param node The node whose keys are to be printed
+/// Turns a skip list into a sorted array
+/// \param list The list
+/// \param array The array to hold the list values, which must fit at least list->length values
+void skip_list_as_array(SkipList *list, int *array) {
+    for (SkipListNode *node = skip_list_begin(list); node; node = skip_list_next(node)) {
+        *array++ = node->value;
+    }
+}
+
+/// Prints the skip list as a one line blank delimited string
+/// \param list The list to print
+void skip_list_print(SkipList *list) {
+    for (SkipListNode *node = skip_list_begin(list); node; node = skip_list_next(node)) {
+        printf("%d ", node->value);
+    }
+
+    printf("\n");
+}
+
+
+/* ### INTEGER ARRAY ###
+ *
+ * A growable vector of integers. The header and the elements live in a single allocation, with the elements starting
+ * on a cache line boundary and the capacity rounded up to whole cache lines, so vectorized loops can always work on
+ * full lines. Growing doubles the capacity, which makes pushing amortized O(1).
+ * Functions which may grow the array take a pointer to the array pointer, because growing moves the whole block.
+ */
+
+
+#define INTEGER_ARRAY_ALIGNMENT 64
+#define INTEGER_ARRAY_ALIGNED_COUNT (INTEGER_ARRAY_ALIGNMENT / sizeof(int))
+
+// DATA STRUCTURES
+
+typedef struct integer_array {
+    size_t length;
+    size_t capacity;
+    int *elements;
+} IntegerArray;
+
+// CONSTRUCTORS AND DESTRUCTORS
+
+/// Destroy an integer array
+/// \param integerArray The integer array
+/// \return NULL
+IntegerArray *destroy_integer_array(IntegerArray *integerArray) {
+    free(integerArray);
+    return NULL;
+}
+
+/// Creates an empty integer array which can hold at least capacity elements before growing
+/// \param capacity The amount of elements to reserve space for
+/// \return A pointer to the new array or NULL in case of a memory allocation failure
+IntegerArray *integer_array_create(size_t capacity) {
+    if (capacity > (SIZE_MAX - sizeof(IntegerArray)) / sizeof(int) - 2 * INTEGER_ARRAY_ALIGNMENT) {
+        return NULL;
+    }
+    capacity = (capacity + INTEGER_ARRAY_ALIGNED_COUNT - 1) / INTEGER_ARRAY_ALIGNED_COUNT * INTEGER_ARRAY_ALIGNED_COUNT;
+    if (capacity == 0) {
+        capacity = INTEGER_ARRAY_ALIGNED_COUNT;
+    }
+
+    // The slack of INTEGER_ARRAY_ALIGNMENT - 1 bytes lets us move the elements to the next cache line boundary
+    IntegerArray *result = malloc(sizeof(IntegerArray) + INTEGER_ARRAY_ALIGNMENT - 1 + capacity * sizeof(int));
+    if (result == NULL) {
+        perror("Could not allocate memory!");
+        return NULL;
+    }
+
+    uintptr_t elements = (uintptr_t) (result + 1);
+    elements = (elements + INTEGER_ARRAY_ALIGNMENT - 1) & ~(uintptr_t) (INTEGER_ARRAY_ALIGNMENT - 1);
+
+    result->elements = (int *) elements;
+    result->length = 0;
+    result->capacity = capacity;
+
+    return result;
+}
+
+/// Creates a new integer array of given length with all elements set to 0
+/// \param length The length of thr array
+/// \return A pointer to the given array or NULL in case of a memory allocation failure
+IntegerArray *create_integer_array(size_t length) {
+    IntegerArray *result = integer_array_create(length);
+    if (result == NULL) {
+        return NULL;
+    }
+
+    memset(result->elements, 0, length * sizeof(int));
+    result->length = length;
+
+    return result;
+}
+
+// FUNCTIONS
+
+/// Moves the array into a new block with the given capacity, which must fit all elements
+/// \param array Pointer to the array, which is updated on success and left untouched on failure
+/// \param capacity The new capacity
+/// \return 0 on success and 1 in case of memory error
+int integer_array_reallocate(IntegerArray **array, size_t capacity) {
+    IntegerArray *result = integer_array_create(capacity);
+    if (result == NULL) {
+        return 1;
+    }
+
+    memcpy(result->elements, (*array)->elements, (*array)->length * sizeof(int));
+    result->length = (*array)->length;
+
+    destroy_integer_array(*array);
+    *array = result;
+    return 0;
+}
+
+/// Makes sure that the array can hold at least capacity elements without growing
+/// \param array Pointer to the array, which may be moved
+/// \param capacity The amount of elements to reserve space for
+/// \return 0 on success and 1 in case of memory error
+int integer_array_reserve(IntegerArray **array, size_t capacity) {
+    if (capacity <= (*array)->capacity) {
+        return 0;
+    }
+    return integer_array_reallocate(array, capacity);
+}
+
+/// Makes room for additional elements, at least doubling the capacity if the array has to grow
+/// \param array Pointer to the array, which may be moved
+/// \param additional The amount of elements to make room for
+/// \return 0 on success and 1 in case of memory error
+int integer_array_grow(IntegerArray **array, size_t additional) {
+    size_t required = (*array)->length + additional;
+    if (required < additional) {
+        return 1;
+    }
+    if (required <= (*array)->capacity) {
+        return 0;
+    }
+
+    size_t doubled = (*array)->capacity * 2;
+    return integer_array_reallocate(array, required > doubled ? required : doubled);
+}
+
+/// Releases unused capacity, keeping the capacity at whole cache lines
+/// \param array Pointer to the array, which may be moved
+/// \return 0 on success and 1 in case of memory error
+int integer_array_shrink_to_fit(IntegerArray **array) {
+    if ((*array)->capacity - (*array)->length < INTEGER_ARRAY_ALIGNED_COUNT) {
+        return 0;
+    }
+    return integer_array_reallocate(array, (*array)->length);
+}
+
+/// Appends a value in amortized constant time
+/// \param array Pointer to the array, which may be moved
+/// \param value The value to append
+/// \return 0 on success and 1 in case of memory error
+int integer_array_push(IntegerArray **array, int value) {
+    if (integer_array_grow(array, 1)) {
+        return 1;
+    }
+
+    (*array)->elements[(*array)->length++] = value;
+    return 0;
+}
+
+/// Appends count values at once, growing at most once
+/// \param array Pointer to the array, which may be moved
+/// \param values The values to append
+/// \param count The amount of values
+/// \return 0 on success and 1 in case of memory error
+int integer_array_append_range(IntegerArray **array, const int *values, size_t count) {
+    if (integer_array_grow(array, count)) {
+        return 1;
+    }
+
+    memcpy((*array)->elements + (*array)->length, values, count * sizeof(int));
+    (*array)->length += count;
+    return 0;
+}
+
+/// Inserts a value at a given index, moving all following elements one position back
+/// \param array Pointer to the array, which may be moved
+/// \param index The index at which the insertion takes place
+/// \param value The value to insert
+/// \return 0 if insertion was successful, 2 if index was out of range and 1 if memory allocation failed
+int integer_array_insert_at(IntegerArray **array, size_t index, int value) {
+    if (index > (*array)->length) {
+        return 2;
+    }
+    if (integer_array_grow(array, 1)) {
+        return 1;
+    }
+
+    int *elements = (*array)->elements;
+    memmove(elements + index + 1, elements + index, ((*array)->length - index) * sizeof(int));
+    elements[index] = value;
+    ++(*array)->length;
+    return 0;
+}
+
+/// Removes the value at a given index, moving all following elements one position forward
+/// \param array The array
+/// \param index The index of the value to remove
+/// \return 0 if the value was removed and 2 if index was out of range
+int integer_array_erase_at(IntegerArray *array, size_t index) {
+    if (index >= array->length) {
+        return 2;
+    }
+
+    memmove(array->elements + index, array->elements + index + 1, (array->length - index - 1) * sizeof(int));
+    --array->length;
+    return 0;
+}
+
+/// Searches for the first occurrence of a value using the vectorized kernels from simd.h
+/// \param array The array to search in
+/// \param value The value to search for
+/// \return The index of the first occurrence or the array length if the array doesn't contain the value
+size_t integer_array_find(const IntegerArray *array, int value) {
+    return simd_find_first(array->elements, array->length, value);
+}
+
+/// Counts the occurrences of a value
+/// \param array The array to search in
+/// \param value The value to count
+/// \return The amount of elements equal to value
+size_t integer_array_count(const IntegerArray *array, int value) {
+    return simd_count_equal(array->elements, array->length, value);
+}
+
+/// Finds the smallest element
+/// \param array The array to search in
+/// \return The index of the first minimum or the array length if the array is empty
+size_t integer_array_min_index(const IntegerArray *array) {
+    return simd_min_index(array->elements, array->length);
+}
+
+/// Finds the largest element
+/// \param array The array to search in
+/// \return The index of the first maximum or the array length if the array is empty
+size_t integer_array_max_index(const IntegerArray *array) {
+    return simd_max_index(array->elements, array->length);
+}
+
+/// Sums up all elements in 64 bit
+/// \param array The array to sum up
+/// \return The sum
+int64_t integer_array_sum(const IntegerArray *array) {
+    return simd_sum(array->elements, array->length);
+}
+
+/// Checks if the array is sorted in ascending order
+/// \param array The array to check
+/// \return 1 if the array is sorted, else 0
+int integer_array_is_sorted(const IntegerArray *array) {
+    return simd_is_sorted(array->elements, array->length);
+}
+
+/// Prints the integer array as a one line comma delimited string
+/// \param integerArray The array to print
+void print_integer_array(IntegerArray *integerArray) {
+    printf("[");
+    for (size_t i = 0; i < integerArray->length; ++i) {
+        printf("%d", integerArray->elements[i]);
+        if (i != integerArray->length - 1) {
+            printf(", ");
+        }
+    }
+    printf("]\n");
+}
+
+
+/* ### TREE ### */
+
+
+// DATA STRUCTURES
+
+typedef struct tree_node TreeNode;
+
+typedef struct tree_node_array {
+    size_t length;
+    TreeNode **elements;
+} TreeNodeArray;
+
+struct tree_node {
+    size_t degree;
+    size_t last_key_index;
+    TreeNodeArray *children;
+    IntegerArray *keys;
+};
+
+typedef struct tree {
+    TreeNode *root;
+    size_t degree;
+} Tree;
+
+// CONSTRUCTORS AND DESTRUCTORS
+
+/// Destroy a given node array
+/// \param nodeArray The node array to destroy
+/// \return NULL
+TreeNodeArray *destroy_node_array(TreeNodeArray *nodeArray) {
+    if (nodeArray) {
+        free(nodeArray->elements);
+    }
+    free(nodeArray);
+    return NULL;
+}
+
+/// Creates an array of nodes with a given length
+/// \param length The length of the array
+/// \return A pointer to the new array or NULL if memory allocation failed
+TreeNodeArray *create_node_array(size_t length) {
+    TreeNodeArray *result = malloc(sizeof(TreeNodeArray));
+    if (result == NULL) {
+        return NULL;
+    }
+
+    result->elements = calloc(length, sizeof(TreeNode));
+    if (result->elements == NULL) {
+        return destroy_node_array(result);
+    }
+
+    result->length = length;
+
+    return result;
+}
+
+/// Destroys a node and its child nodes recursively
+/// \param node The node to destroy
+/// \return A NULL pointer to clean up the node pointer
+TreeNode *destroy_tree_nodes_recursively(TreeNode *node) {
+    if (node) {
+        node->keys = destroy_integer_array(node->keys);
+        node->children = destroy_node_array(node->children);
+    }
+    free(node);
+    return NULL;
+}
+
+/// Creates a new node of given degree
+/// \param degree The degree of the node
+/// \return A pointer to the new node or NULL in case of memory allocation failure
+TreeNode *create_tree_node(size_t degree) {
+
+    TreeNode *result = malloc(sizeof(TreeNode));
+    if (result == NULL) {
+        return NULL;
+    }
+
+    result->keys = create_integer_array(degree - 1);
+    result->children = create_node_array(degree);
+    if (result->keys == NULL || result->children == NULL) {
+        return destroy_tree_nodes_recursively(result);
+    }
+
+    result->degree = degree;
+    result->last_key_index = 0;
+
+    return result;
+}
+
+/// Creates a new n-ary tree
+/// \param degree The degree
+/// \return A pointer to the new tree or NULL in case of memory error or if the degree is invalid (lower than 2)
+Tree *create_tree(size_t degree) {
+    if (degree < 2) {
+        return NULL;
+    }
+
+    Tree *result = malloc(sizeof(Tree));
+    if (result == NULL) {
+        return NULL;
+    }
+
+    result->root = NULL;
+    result->degree = degree;
+    return result;
+}
+
+/// Destroys the tree, recursively destroying its nodes
+/// \param tree The tree to destroy
+/// \return A NULL pointer to clean up the tree pointer
+Tree *destroy_tree(Tree *tree) {
+    if (tree) {
+        tree->root = destroy_tree_nodes_recursively(tree->root);
+    }
+    free(tree);
+    return NULL;
+}
+
+// FUNCTIONS
+
+/// Prints tree_node keys, also showing how many of the key slots are still unset
+/// \param node The node whose keys are to be printed
 void print_tree_node_keys(TreeNode *node) {
     printf("[");
     for (size_t j = 0; j < node->keys->length; ++j) {
@@ -454,345 +1029,1430 @@ int add_to_tree_internal(TreeNode *node, int value) {
                 return 0;
             }
         }
-        else if (i == node->degree - 2){
-            if (node->children->elements[i + 1] != NULL) {
-                return add_to_tree_internal(node->children->elements[i + 1], value);
-            } else {
-                node->children->elements[i + 1] = create_tree_node(node->degree);
-                if (node->children->elements[i + 1] == NULL) {
-                    return 1;
-                }
-                node->children->elements[i + 1]->keys->elements[0] = value;
-                node->children->elements[i + 1]->last_key_index += 1;
-                return 0;
+        else if (i == node->degree - 2){
+            if (node->children->elements[i + 1] != NULL) {
+                return add_to_tree_internal(node->children->elements[i + 1], value);
+            } else {
+                node->children->elements[i + 1] = create_tree_node(node->degree);
+                if (node->children->elements[i + 1] == NULL) {
+                    return 1;
+                }
+                node->children->elements[i + 1]->keys->elements[0] = value;
+                node->children->elements[i + 1]->last_key_index += 1;
+                return 0;
+            }
+        }
+    }
+
+    return 3;
+}
+
+/// Adds a new value to the tree and creates a root tree_node if the tree is empty
+/// \param tree The tree to extend
+/// \param value The value to insert
+/// \return 0 if insertion was successful, else 1 in case of memory error
+int add_to_tree(Tree *tree, int value) {
+    if (tree->root == NULL) {
+        tree->root = create_tree_node(tree->degree);
+        if (tree->root == NULL) {
+            return 1;
+        }
+        tree->root->keys->elements[0] = value;
+        tree->root->last_key_index = 1;
+    } else {
+        if (add_to_tree_internal(tree->root, value)) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/// Prints all the nodes recursively, indenting them for better readability
+/// \param node The node to start printing from
+/// \param depth The depth of printing, this should be 1 initially
+void print_tree_nodes(TreeNode *node, size_t depth){
+    if (node) {
+        for (size_t key_index = 0; key_index < node->last_key_index; key_index++) {
+            if (node->children->elements[key_index] != NULL) {
+                print_tree_nodes(node->children->elements[key_index], depth + 1);
+            }
+        }
+
+        for (size_t indentations = 1; indentations < depth; indentations++) {
+            printf("\t");
+        }
+
+        print_tree_node_keys(node);
+
+        if (node->children->elements[node->degree - 1]) {
+            print_tree_nodes(node->children->elements[node->degree - 1], depth + 1);
+        }
+    }
+}
+
+/// Prints all the nodes of a tree recursively, indenting them for better readability
+/// \param tree The tree to print
+void print_tree(Tree *tree) {
+    print_tree_nodes(tree->root, 1);
+}
+
+/// Checks if a given value is contained by a node or its child nodes
+/// \param node The node to start searching at
+/// \param value The value to search for
+/// \return A pointer to the found node or NULL if the value is not found
+TreeNode *search_in_tree_internal(TreeNode *node, int value) {
+
+    if (!node) {
+        return NULL;
+    }
+
+    for (size_t i = 0; i < node->last_key_index; ++i) {
+
+        // Check if value is in the keys
+        if (node->keys->elements[i] == value) {
+            return node;
+        }
+        // Else check if it's too small to fit, so we need to go down the left subtree
+        else if (value < node->keys->elements[i]) {
+            return search_in_tree_internal(node->children->elements[i], value);
+        }
+        // Else check if we are at the last key
+        else if (i == node->degree - 2) {
+            // Now value is bigger than the last element and could only be in the right child
+            // Only the last key in the array can have a right child
+            return search_in_tree_internal(node->children->elements[i + 1], value);
+        }
+    }
+    return NULL;
+}
+
+/// Checks if a given value is in a tree
+/// \param tree The tree in which to search
+/// \param value The value to search for
+/// \return A pointer to the found node or NULL if the value is not found
+TreeNode *search_in_tree(Tree *tree, int value) {
+    return search_in_tree_internal(tree->root, value);
+}
+
+
+/* ### BINARY TREE ###
+ *
+ * This is separate from Tree since it includes tracking the parent element and removal
+ *
+ * A plain tree keeps the shape the insertion order gives it, so sorted input turns it into a list. An AVL tree
+ * rebalances after every insertion and deletion, which keeps its height below 1.44 log2(n). A splay tree rotates
+ * every node it inserts or finds up to the root, so frequently used values stay near the top and skewed workloads get
+ * short paths, at amortized O(log n) per operation. Searching a splay tree changes its shape.
+ *
+ * Every node knows the size of its subtree, which answers order statistics like the k-th smallest value or the amount
+ * of values in a range in O(height) instead of a full traversal.
+ *
+ * Iterators and range scans walk along the parent pointers, so streaming the values in order needs neither recursion
+ * nor an auxiliary stack. An iterator only stays valid as long as the tree is not changed.
+ *
+ * Sorted values can be turned into a balanced tree in O(n) at once, with all nodes in one block of memory. Very large
+ * inputs are built by several threads if thread support is enabled, which happens by default when compiling with
+ * -pthread and can be forced with -DBINARY_TREE_THREADS=1.
+ *
+ * */
+
+#ifndef BINARY_TREE_THREADS
+#if defined(_REENTRANT)
+#define BINARY_TREE_THREADS 1
+#else
+#define BINARY_TREE_THREADS 0
+#endif
+#endif
+
+#if BINARY_TREE_THREADS
+#include <pthread.h>
+#endif
+
+/// Subtrees below this amount of nodes are always built by the calling thread
+#define BINARY_TREE_PARALLEL_CUTOFF 65536
+
+
+// DATA STRUCTURES
+
+typedef struct binary_tree_node BinaryTreeNode;
+
+struct binary_tree_node {
+    int value;
+    int height;
+    size_t size;
+    BinaryTreeNode *left;
+    BinaryTreeNode *right;
+    BinaryTreeNode *parent;
+};
+
+typedef enum {BINARY_TREE_PLAIN, BINARY_TREE_AVL, BINARY_TREE_SPLAY} BinaryTreeMode;
+
+/// If pool is set, all nodes are allocated from it
+typedef struct binary_tree {
+    BinaryTreeNode *root;
+    MemoryPool *pool;
+    BinaryTreeMode mode;
+} BinaryTree;
+
+/// Points to the node whose value is returned next, NULL once all values have been returned
+typedef struct binary_tree_iterator {
+    BinaryTreeNode *node;
+} BinaryTreeIterator;
+
+/// Called by range scans for every value, a return value other than 0 stops the scan
+typedef int (*binary_tree_visitor)(int value, void *context);
+
+/// A range of sorted values to be built into a subtree, so it can be built in its own thread
+typedef struct binary_tree_build_task {
+    const int *values;
+    BinaryTreeNode *nodes;
+    size_t length;
+    size_t depth;
+    BinaryTreeNode *result;
+} BinaryTreeBuildTask;
+
+// CONSTRUCTORS AND DESTRUCTORS
+
+/// Creates a new binary tree node
+/// \param pool The pool to allocate the node from or NULL to use malloc
+/// \param value The value of the new node
+/// \return A pointer to the new node or NULL in case of memory error
+BinaryTreeNode *create_binary_tree_node(MemoryPool *pool, int value) {
+
+    BinaryTreeNode *result = pool ? memory_pool_allocate(pool) : malloc(sizeof(BinaryTreeNode));
+    if (result == NULL) {
+        return NULL;
+    }
+
+    result->left = NULL;
+    result->right = NULL;
+    result->parent = NULL;
+    result->value = value;
+    result->height = 1;
+    result->size = 1;
+
+    return result;
+}
+
+/// Destroys a single node, unlinking it from its parent
+/// \param pool The pool the node was allocated from or NULL if it was allocated using malloc
+/// \param node The node to destroy
+/// \return A NULL pointer to clean up the node pointer
+BinaryTreeNode *destroy_binary_tree_node(MemoryPool *pool, BinaryTreeNode *node) {
+    if (node) {
+        if (node->parent) {
+            if (node->parent->left == node) {
+                node->parent->left = NULL;
+            } else {
+                node->parent->right = NULL;
+            }
+        }
+    }
+    if (pool) {
+        memory_pool_free(pool, node);
+    } else {
+        free(node);
+    }
+    return NULL;
+}
+
+/// Destroys a node and all of its descendants without recursion. Rotating every left child up turns the subtree into
+/// a chain of right children, which is freed while walking down, so the cost is O(n) and no stack is needed
+/// \param node The subtree to destroy
+/// \return A NULL pointer to clean up the node pointer
+BinaryTreeNode *destroy_binary_tree_nodes_recursively(BinaryTreeNode *node) {
+    while (node) {
+        if (node->left) {
+            BinaryTreeNode *left = node->left;
+            node->left = left->right;
+            left->right = node;
+            node = left;
+        } else {
+            BinaryTreeNode *right = node->right;
+            free(node);
+            node = right;
+        }
+    }
+    return NULL;
+}
+
+/// Creates an empty binary tree
+/// \param mode BINARY_TREE_PLAIN, BINARY_TREE_AVL to keep the tree balanced or BINARY_TREE_SPLAY to keep recently used
+/// values near the root
+/// \param pool The pool to allocate the nodes from or NULL to use malloc. The tree takes ownership of the pool, so the
+/// pool must not be shared with other structures
+/// \return A pointer to the tree or NULL in case of memory error
+BinaryTree *create_binary_tree_with_mode(BinaryTreeMode mode, MemoryPool *pool) {
+
+    BinaryTree *result = malloc(sizeof(BinaryTree));
+    if (result == NULL) {
+        return NULL;
+    }
+
+    result->root = NULL;
+    result->pool = pool;
+    result->mode = mode;
+    return result;
+}
+
+BinaryTree *create_binary_tree() {
+    return create_binary_tree_with_mode(BINARY_TREE_PLAIN, NULL);
+}
+
+/// Creates a binary tree which allocates its nodes from a pool. The tree takes ownership of the pool, so the pool must
+/// not be shared with other structures
+/// \param pool A pool with an element size of at least sizeof(BinaryTreeNode)
+/// \return A pointer to the tree or NULL in case of memory error
+BinaryTree *create_binary_tree_pooled(MemoryPool *pool) {
+    return create_binary_tree_with_mode(BINARY_TREE_PLAIN, pool);
+}
+
+/// Destroys the tree and all of its nodes. A pooled tree is released together with its pool in one step
+/// \param tree The tree to destroy
+/// \return A NULL pointer to clean up the tree pointer
+BinaryTree *destroy_binary_tree(BinaryTree *tree) {
+    if (tree) {
+        if (tree->pool) {
+            tree->pool = memory_pool_destroy(tree->pool);
+            tree->root = NULL;
+        } else {
+            tree->root = destroy_binary_tree_nodes_recursively(tree->root);
+        }
+    }
+    free(tree);
+    return NULL;
+}
+
+// FUNCTIONS
+
+/// Returns the height of a subtree as maintained by AVL trees
+/// \param node The subtree, which may be NULL
+/// \return The height, 0 for an empty subtree
+int binary_tree_node_height(BinaryTreeNode *node) {
+    return node ? node->height : 0;
+}
+
+/// Returns the amount of nodes in a subtree
+/// \param node The subtree, which may be NULL
+/// \return The size, 0 for an empty subtree
+size_t binary_tree_node_size(BinaryTreeNode *node) {
+    return node ? node->size : 0;
+}
+
+/// Recomputes the values a node derives from its children. Must be called whenever the children of a node change
+/// \param node The node to update
+void binary_tree_node_update(BinaryTreeNode *node) {
+    int left = binary_tree_node_height(node->left);
+    int right = binary_tree_node_height(node->right);
+    node->height = (left > right ? left : right) + 1;
+    node->size = binary_tree_node_size(node->left) + binary_tree_node_size(node->right) + 1;
+}
+
+/// Updates node and all of its ancestors after the subtree below node changed
+/// \param node The lowest node whose subtree changed, may be NULL
+void binary_tree_update_path(BinaryTreeNode *node) {
+    while (node) {
+        binary_tree_node_update(node);
+        node = node->parent;
+    }
+}
+
+/// Replaces the child pointer of node's parent, or the root if node has no parent
+/// \param tree The tree
+/// \param node The node to replace
+/// \param replacement The node taking its place
+void binary_tree_replace_child(BinaryTree *tree, BinaryTreeNode *node, BinaryTreeNode *replacement) {
+    BinaryTreeNode *parent = node->parent;
+    if (parent == NULL) {
+        tree->root = replacement;
+    } else if (parent->left == node) {
+        parent->left = replacement;
+    } else {
+        parent->right = replacement;
+    }
+    if (replacement) {
+        replacement->parent = parent;
+    }
+}
+
+/// Rotates node down to the left, so its right child takes its place
+/// \param tree The tree
+/// \param node The node to rotate, which needs a right child
+/// \return The right child, which is the new root of the subtree
+BinaryTreeNode *binary_tree_rotate_left(BinaryTree *tree, BinaryTreeNode *node) {
+    BinaryTreeNode *pivot = node->right;
+
+    node->right = pivot->left;
+    if (pivot->left) {
+        pivot->left->parent = node;
+    }
+
+    binary_tree_replace_child(tree, node, pivot);
+    pivot->left = node;
+    node->parent = pivot;
+
+    binary_tree_node_update(node);
+    binary_tree_node_update(pivot);
+    return pivot;
+}
+
+/// Rotates node down to the right, so its left child takes its place
+/// \param tree The tree
+/// \param node The node to rotate, which needs a left child
+/// \return The left child, which is the new root of the subtree
+BinaryTreeNode *binary_tree_rotate_right(BinaryTree *tree, BinaryTreeNode *node) {
+    BinaryTreeNode *pivot = node->left;
+
+    node->left = pivot->right;
+    if (pivot->right) {
+        pivot->right->parent = node;
+    }
+
+    binary_tree_replace_child(tree, node, pivot);
+    pivot->right = node;
+    node->parent = pivot;
+
+    binary_tree_node_update(node);
+    binary_tree_node_update(pivot);
+    return pivot;
+}
+
+/// Rotates a node one level up, above its parent
+/// \param tree The tree
+/// \param node The node to rotate, which needs a parent
+void binary_tree_rotate_up(BinaryTree *tree, BinaryTreeNode *node) {
+    if (node->parent->left == node) {
+        binary_tree_rotate_right(tree, node->parent);
+    } else {
+        binary_tree_rotate_left(tree, node->parent);
+    }
+}
+
+/// Moves a node up to the root. A node in line with its parent and grandparent rotates the parent first, which roughly
+/// halves the depth of all nodes on the path and gives splay trees their amortized bound
+/// \param tree The tree
+/// \param node The node to move to the root
+void binary_tree_splay(BinaryTree *tree, BinaryTreeNode *node) {
+    while (node->parent) {
+        BinaryTreeNode *parent = node->parent;
+        BinaryTreeNode *grandparent = parent->parent;
+
+        if (grandparent && (grandparent->left == parent) == (parent->left == node)) {
+            binary_tree_rotate_up(tree, parent);
+        } else if (grandparent) {
+            binary_tree_rotate_up(tree, node);
+        }
+        binary_tree_rotate_up(tree, node);
+    }
+}
+
+/// Walks from node up to the root, updating heights and sizes. AVL trees restore their balance with rotations on the
+/// way
+/// \param tree The tree
+/// \param node The lowest node whose subtree changed
+void binary_tree_rebalance(BinaryTree *tree, BinaryTreeNode *node) {
+    if (tree->mode != BINARY_TREE_AVL) {
+        binary_tree_update_path(node);
+        return;
+    }
+
+    while (node) {
+        binary_tree_node_update(node);
+        int balance = binary_tree_node_height(node->left) - binary_tree_node_height(node->right);
+
+        // A child leaning the other way needs to be rotated first, which turns the double rotation into two single ones
+        if (balance > 1) {
+            if (binary_tree_node_height(node->left->left) < binary_tree_node_height(node->left->right)) {
+                binary_tree_rotate_left(tree, node->left);
+            }
+            node = binary_tree_rotate_right(tree, node);
+        } else if (balance < -1) {
+            if (binary_tree_node_height(node->right->right) < binary_tree_node_height(node->right->left)) {
+                binary_tree_rotate_right(tree, node->right);
+            }
+            node = binary_tree_rotate_left(tree, node);
+        }
+
+        node = node->parent;
+    }
+}
+
+/// Adds a new node with give value below a node, without rebalancing or updating the ancestors
+/// \param node The node at which the insertion starts
+/// \param value The value to insert
+/// \param pool The pool to allocate the new node from or NULL to use malloc
+/// \return The new node or NULL in case of memory error or if node is NULL
+BinaryTreeNode *binary_tree_attach(BinaryTreeNode *node, int value, MemoryPool *pool) {
+
+    // Walk down to the empty child slot the value belongs into
+    while (node) {
+        BinaryTreeNode **child = (node->value >= value) ? &node->left : &node->right;
+        if (*child == NULL) {
+            *child = create_binary_tree_node(pool, value);
+            if (*child) {
+                (*child)->parent = node;
             }
+            return *child;
         }
+        node = *child;
     }
+    return NULL;
+}
 
-    return 3;
+/// Adds a new node with give value to the tree
+/// \param node The node at which the insertion starts
+/// \param value The value to insert
+/// \param pool The pool to allocate the new node from or NULL to use malloc
+/// \return 0 if successful, else 1 in case of memory error
+int add_to_binary_tree_internal(BinaryTreeNode *node, int value, MemoryPool *pool) {
+    BinaryTreeNode *result = binary_tree_attach(node, value, pool);
+    if (result == NULL) {
+        return node != NULL;
+    }
+
+    binary_tree_update_path(result->parent);
+    return 0;
 }
 
-/// Adds a new value to the tree and creates a root tree_node if the tree is empty
+/// Adds a new value to the tree and creates a root node if the tree is empty
 /// \param tree The tree to extend
 /// \param value The value to insert
-/// \return 0 if insertion was successful, else 1 in case of memory error
-int add_to_tree(Tree *tree, int value) {
+/// \return 0 if successful, else 1 in case of memory error
+int add_to_binary_tree(BinaryTree *tree, int value) {
     if (tree->root == NULL) {
-        tree->root = create_tree_node(tree->degree);
+        tree->root = create_binary_tree_node(tree->pool, value);
         if (tree->root == NULL) {
             return 1;
         }
-        tree->root->keys->elements[0] = value;
-        tree->root->last_key_index = 1;
     } else {
-        if (add_to_tree_internal(tree->root, value)) {
+        BinaryTreeNode *node = binary_tree_attach(tree->root, value, tree->pool);
+        if (node == NULL) {
             return 1;
         }
+        binary_tree_rebalance(tree, node->parent);
+        if (tree->mode == BINARY_TREE_SPLAY) {
+            binary_tree_splay(tree, node);
+        }
     }
     return 0;
 }
 
 /// Prints all the nodes recursively, indenting them for better readability
-/// \param node The node to start printing from
-/// \param depth The depth of printing, this should be 1 initially
-void print_tree_nodes(TreeNode *node, size_t depth){
+/// \param node The subtree which is printed
+/// \param depth The depth of indentation. This parameter is used in recursion and should remain 1
+void print_binary_tree_nodes(BinaryTreeNode *node, size_t depth){
     if (node) {
-        for (size_t key_index = 0; key_index < node->last_key_index; key_index++) {
-            if (node->children->elements[key_index] != NULL) {
-                print_tree_nodes(node->children->elements[key_index], depth + 1);
-            }
+        if (node->left) {
+            print_binary_tree_nodes(node->left, depth + 1);
         }
 
         for (size_t indentations = 1; indentations < depth; indentations++) {
             printf("\t");
         }
 
-        print_tree_node_keys(node);
+        printf("%d\n", node->value);
 
-        if (node->children->elements[node->degree - 1]) {
-            print_tree_nodes(node->children->elements[node->degree - 1], depth + 1);
+        if (node->right) {
+            print_binary_tree_nodes(node->right, depth + 1);
         }
     }
 }
 
-/// Prints all the nodes of a tree recursively, indenting them for better readability
+/// Prints all the nodes of the tree recursively, indenting them for better readability
 /// \param tree The tree to print
-void print_tree(Tree *tree) {
-    print_tree_nodes(tree->root, 1);
+void print_binary_tree(BinaryTree *tree) {
+    print_binary_tree_nodes(tree->root, 1);
+    printf("\n");
 }
 
-/// Checks if a given value is contained by a node or its child nodes
-/// \param node The node to start searching at
-/// \param value The value to search for
-/// \return A pointer to the found node or NULL if the value is not found
-TreeNode *search_in_tree_internal(TreeNode *node, int value) {
+/// Searches a value inside a subtree and fetches the respective node if found
+/// \param node The subtree to search in
+/// \param value The value to search
+/// \return A pointer to the containing BinaryTreeNode or NULL, if the subtree doesn't contain the value
+BinaryTreeNode *search_in_binary_tree_internal(BinaryTreeNode *node, int value) {
 
-    if (!node) {
-        return NULL;
+    while (node && node->value != value) {
+        node = (value < node->value) ? node->left : node->right;
     }
+    return node;
+}
 
-    for (size_t i = 0; i < node->last_key_index; ++i) {
+/// Searches a value inside a tree and fetches the respective node if found. A splay tree moves the found node, or the
+/// last one visited if the value is missing, up to the root
+/// \param tree The tree to search in
+/// \param value The value to search
+/// \return A pointer to the containing BinaryTreeNode or NULL, if the tree doesn't contain the value
+BinaryTreeNode *search_in_binary_tree(BinaryTree *tree, int value) {
+    if (tree->mode != BINARY_TREE_SPLAY) {
+        return search_in_binary_tree_internal(tree->root, value);
+    }
 
-        // Check if value is in the keys
-        if (node->keys->elements[i] == value) {
+    BinaryTreeNode *last = NULL;
+    BinaryTreeNode *node = tree->root;
+    while (node && node->value != value) {
+        last = node;
+        node = (value < node->value) ? node->left : node->right;
+    }
+
+    if (node || last) {
+        binary_tree_splay(tree, node ? node : last);
+    }
+    return node;
+}
+
+/// Returns the rightmost node of a given node
+/// \param node The node from where to start searching
+/// \return The rightmost node or the node itself if it has no right node
+BinaryTreeNode *rightmost_node_of_(BinaryTreeNode *node) {
+    while (node->right) {
+        node = node->right;
+    }
+    return node;
+}
+
+/// Returns the leftmost node of a given node
+/// \param node The node from where to start searching
+/// \return The leftmost node or the node itself if it has no left node
+BinaryTreeNode *leftmost_node_of_(BinaryTreeNode *node) {
+    while (node->left) {
+        node = node->left;
+    }
+    return node;
+}
+
+/// Returns the in-order successor of a node by following the parent pointers
+/// \param node The node to start at
+/// \return The node holding the next value in sorted order or NULL if node holds the last one
+BinaryTreeNode *binary_tree_node_next(BinaryTreeNode *node) {
+    if (node->right) {
+        return leftmost_node_of_(node->right);
+    }
+    while (node->parent && node->parent->right == node) {
+        node = node->parent;
+    }
+    return node->parent;
+}
+
+/// Creates an iterator starting at the smallest value of the tree
+/// \param tree The tree to iterate
+/// \return The iterator
+BinaryTreeIterator binary_tree_begin(BinaryTree *tree) {
+    BinaryTreeIterator result = {tree->root ? leftmost_node_of_(tree->root) : NULL};
+    return result;
+}
+
+/// Creates an iterator starting at the smallest value which is at least as big as value
+/// \param tree The tree to iterate
+/// \param value The value to start at, which does not have to be contained
+/// \return The iterator, which is already exhausted if all values are smaller
+BinaryTreeIterator binary_tree_seek(BinaryTree *tree, int value) {
+    BinaryTreeIterator result = {NULL};
+    BinaryTreeNode *node = tree->root;
+
+    // The last node at which the walk turned left is the first one in order which is not smaller
+    while (node) {
+        if (node->value < value) {
+            node = node->right;
+        } else {
+            result.node = node;
+            node = node->left;
+        }
+    }
+    return result;
+}
+
+/// Fetches the next value of an iterator and advances it
+/// \param iterator The iterator
+/// \param value Receives the value if there is one
+/// \return 1 if a value was fetched, else 0 if the iterator is exhausted
+int binary_tree_next(BinaryTreeIterator *iterator, int *value) {
+    if (iterator->node == NULL) {
+        return 0;
+    }
+
+    *value = iterator->node->value;
+    iterator->node = binary_tree_node_next(iterator->node);
+    return 1;
+}
+
+/// Visits all values between lo and hi in ascending order. The scan starts at the first value not smaller than lo and
+/// stops behind hi, so apart from finding the start it only touches nodes inside the range
+/// \param tree The tree to scan
+/// \param lo The lower bound, included
+/// \param hi The upper bound, included
+/// \param visitor The function to call for every value
+/// \param context Passed to every call of visitor
+/// \return The amount of visited values
+size_t binary_tree_range_scan(BinaryTree *tree, int lo, int hi, binary_tree_visitor visitor, void *context) {
+    size_t count = 0;
+    BinaryTreeIterator iterator = binary_tree_seek(tree, lo);
+    int value;
+
+    while (binary_tree_next(&iterator, &value) && value <= hi) {
+        ++count;
+        if (visitor(value, context)) {
+            break;
+        }
+    }
+    return count;
+}
+
+/// Measures the height of the tree by walking it along the parent pointers, which works for every mode and shape
+/// \param tree The tree
+/// \return The amount of nodes on the longest path from the root to a leaf
+size_t binary_tree_height(BinaryTree *tree) {
+    size_t height = 0;
+    size_t depth = 0;
+    BinaryTreeNode *previous = NULL;
+    BinaryTreeNode *node = tree->root;
+
+    while (node) {
+        BinaryTreeNode *next;
+        if (previous == node->parent) {
+            // Arrived from above
+            if (++depth > height) {
+                height = depth;
+            }
+            next = node->left ? node->left : node->right ? node->right : node->parent;
+        } else if (previous == node->left && node->right) {
+            // Done with the left subtree
+            next = node->right;
+        } else {
+            next = node->parent;
+        }
+
+        if (next == node->parent) {
+            --depth;
+        }
+        previous = node;
+        node = next;
+    }
+
+    return height;
+}
+
+/// Fetches the node holding the k-th smallest value
+/// \param tree The tree to search in
+/// \param k The position in sorted order, starting at 0
+/// \return The node or NULL if the tree holds k or less values
+BinaryTreeNode *binary_tree_select(BinaryTree *tree, size_t k) {
+    BinaryTreeNode *node = tree->root;
+
+    while (node) {
+        size_t left = binary_tree_node_size(node->left);
+        if (k < left) {
+            node = node->left;
+        } else if (k == left) {
             return node;
+        } else {
+            k -= left + 1;
+            node = node->right;
         }
-        // Else check if it's too small to fit, so we need to go down the left subtree
-        else if (value < node->keys->elements[i]) {
-            return search_in_tree_internal(node->children->elements[i], value);
+    }
+    return NULL;
+}
+
+/// Counts the values of a subtree which are below a bound
+/// \param node The subtree
+/// \param bound The bound
+/// \param inclusive Whether values equal to bound are counted as well
+/// \return The amount of values below or up to bound
+size_t binary_tree_count_below(BinaryTreeNode *node, int bound, int inclusive) {
+    size_t count = 0;
+
+    // Whenever a node is counted, its whole left subtree is as well, so only one path down has to be visited
+    while (node) {
+        if (node->value < bound || (inclusive && node->value == bound)) {
+            count += binary_tree_node_size(node->left) + 1;
+            node = node->right;
+        } else {
+            node = node->left;
         }
-        // Else check if we are at the last key
-        else if (i == node->degree - 2) {
-            // Now value is bigger than the last element and could only be in the right child
-            // Only the last key in the array can have a right child
-            return search_in_tree_internal(node->children->elements[i + 1], value);
+    }
+    return count;
+}
+
+/// Returns the rank of a value, i.e. the position it has or would have in sorted order
+/// \param tree The tree
+/// \param value The value, which does not have to be contained
+/// \return The amount of values in the tree which are smaller than value
+size_t binary_tree_rank(BinaryTree *tree, int value) {
+    return binary_tree_count_below(tree->root, value, 0);
+}
+
+/// Counts the values of the tree inside a closed range
+/// \param tree The tree
+/// \param lo The lower bound, included
+/// \param hi The upper bound, included
+/// \return The amount of values between lo and hi, 0 if lo is bigger than hi
+size_t binary_tree_count_range(BinaryTree *tree, int lo, int hi) {
+    if (lo > hi) {
+        return 0;
+    }
+    return binary_tree_count_below(tree->root, hi, 1) - binary_tree_count_below(tree->root, lo, 0);
+}
+
+/// Moves values of the in-order neighbours up into target until the node to remove is a leaf. Only the returned leaf
+/// has to be unlinked afterwards, so the shape of the tree changes in a single place
+/// \param target The node whose value is to be removed
+/// \return The leaf to remove
+BinaryTreeNode *binary_tree_leaf_for_removal(BinaryTreeNode *target) {
+    while (target->left || target->right) {
+        BinaryTreeNode *replacement = target->left ? rightmost_node_of_(target->left)
+                                                   : leftmost_node_of_(target->right);
+        target->value = replacement->value;
+        target = replacement;
+    }
+    return target;
+}
+
+/// Deletes the node with value from the subtree starting at node, without rebalancing
+/// \param node The root from which to start looking
+/// \param value The value of the node to be deleted
+/// \param pool The pool the nodes were allocated from or NULL if they were allocated using malloc
+/// \return 0 if the node was successfully deleted, else 1 if the given value was not in the subtree
+int delete_binary_tree_node_internal(BinaryTreeNode *node, int value, MemoryPool *pool) {
+    BinaryTreeNode *target = search_in_binary_tree_internal(node, value);
+    if (target == NULL) {
+        return 1;
+    }
+
+    BinaryTreeNode *leaf = binary_tree_leaf_for_removal(target);
+    BinaryTreeNode *parent = leaf->parent;
+    destroy_binary_tree_node(pool, leaf);
+    binary_tree_update_path(parent);
+    return 0;
+}
+
+/// Deletes a node holding value from the tree, rebalancing it if it is an AVL tree and splaying the parent of the
+/// removed node if it is a splay tree
+/// \param tree The tree to delete from
+/// \param value The value of the node to be deleted
+/// \return 0 if the node was successfully deleted, else 1 if the given value was not in the tree
+int delete_binary_tree_node(BinaryTree *tree, int value) {
+    BinaryTreeNode *target = search_in_binary_tree_internal(tree->root, value);
+    if (target == NULL) {
+        return 1;
+    }
+
+    BinaryTreeNode *leaf = binary_tree_leaf_for_removal(target);
+    BinaryTreeNode *parent = leaf->parent;
+    if (leaf == tree->root) {
+        tree->root = NULL;
+    }
+
+    destroy_binary_tree_node(tree->pool, leaf);
+    binary_tree_rebalance(tree, parent);
+    if (tree->mode == BINARY_TREE_SPLAY && parent) {
+        binary_tree_splay(tree, parent);
+    }
+    return 0;
+}
+
+BinaryTreeNode *binary_tree_build(const int *values, BinaryTreeNode *nodes, size_t length, size_t depth) ;
+
+void *binary_tree_build_task_run(void *argument) {
+    BinaryTreeBuildTask *task = argument;
+    task->result = binary_tree_build(task->values, task->nodes, task->length, task->depth);
+    return NULL;
+}
+
+/// Builds a perfectly balanced subtree from sorted values. The node of values[i] is nodes[i], so the nodes are laid
+/// out in sorted order. The left half is built in a new thread if depth allows it and the range is big enough
+/// \param values The values in ascending order
+/// \param nodes Uninitialized memory for length nodes
+/// \param length The amount of values
+/// \param depth The amount of recursion levels which may still start new threads
+/// \return The root of the subtree, whose parent still has to be set, or NULL if length is 0
+BinaryTreeNode *binary_tree_build(const int *values, BinaryTreeNode *nodes, size_t length, size_t depth) {
+    if (length == 0) {
+        return NULL;
+    }
+
+    size_t middle = length / 2;
+    BinaryTreeNode *node = nodes + middle;
+    BinaryTreeBuildTask task = {values, nodes, middle, depth ? depth - 1 : 0, NULL};
+
+#if BINARY_TREE_THREADS
+    pthread_t thread;
+    int parallel = depth > 0 && length >= BINARY_TREE_PARALLEL_CUTOFF
+                   && pthread_create(&thread, NULL, binary_tree_build_task_run, &task) == 0;
+#else
+    int parallel = 0;
+#endif
+
+    if (!parallel) {
+        binary_tree_build_task_run(&task);
+    }
+    node->right = binary_tree_build(values + middle + 1, nodes + middle + 1, length - middle - 1, task.depth);
+#if BINARY_TREE_THREADS
+    if (parallel) {
+        pthread_join(thread, NULL);
+    }
+#endif
+
+    node->value = values[middle];
+    node->left = task.result;
+    node->parent = NULL;
+    if (node->left) {
+        node->left->parent = node;
+    }
+    if (node->right) {
+        node->right->parent = node;
+    }
+    binary_tree_node_update(node);
+    return node;
+}
+
+/// Builds a balanced AVL tree from sorted values in O(n). All nodes are allocated in one block in sorted order, so
+/// in-order traversals walk through memory sequentially. Afterwards the tree can be changed like any other AVL tree
+/// \param values The values in ascending order
+/// \param length The amount of values
+/// \param threads The amount of threads to use for very large inputs, 1 to stay in the calling thread. Ignored without
+/// thread support
+/// \return A pointer to the tree or NULL in case of memory error
+BinaryTree *binary_tree_from_sorted_parallel(const int *values, size_t length, size_t threads) {
+    MemoryPool *pool = memory_pool_create(sizeof(BinaryTreeNode), 4096);
+    BinaryTree *result = pool ? create_binary_tree_with_mode(BINARY_TREE_AVL, pool) : NULL;
+    if (result == NULL) {
+        memory_pool_destroy(pool);
+        return NULL;
+    }
+    if (length == 0) {
+        return result;
+    }
+
+    BinaryTreeNode *nodes = memory_pool_allocate_array(pool, length);
+    if (nodes == NULL) {
+        return destroy_binary_tree(result);
+    }
+    assert(pool->element_size == sizeof(BinaryTreeNode));
+
+    size_t depth = 0;
+    while (threads > ((size_t) 1 << depth)) {
+        ++depth;
+    }
+
+    result->root = binary_tree_build(values, nodes, length, depth);
+    return result;
+}
+
+/// Builds a balanced AVL tree from sorted values in O(n) in the calling thread
+/// \param values The values in ascending order
+/// \param length The amount of values
+/// \return A pointer to the tree or NULL in case of memory error
+BinaryTree *binary_tree_from_sorted(const int *values, size_t length) {
+    return binary_tree_from_sorted_parallel(values, length, 1);
+}
+
+
+/* ### BINARY TREE SNAPSHOT ###
+ *
+ * An immutable copy of a Binary Tree's values for read-mostly workloads. The values are stored in Eytzinger order, i.e.
+ * the breadth first order of a perfectly balanced tree: the children of index k are 2k and 2k + 1, starting at k = 1.
+ * A search touches the same amount of values as on a balanced tree, but without pointers, and the top levels share a
+ * few cache lines. Since the next index is computed instead of branched on, the descendants four levels down can be
+ * prefetched while the current level is compared.
+ *
+ * A snapshot never changes, so any amount of readers may query it while a writer keeps changing the tree. The writer
+ * freezes the tree again whenever the readers should see the changes and swaps the snapshot pointer.
+ * */
+
+
+#define BINARY_TREE_SNAPSHOT_ALIGNMENT 64
+/// The amount of values in a cache line, which is the distance between an index and its descendants four levels down
+#define BINARY_TREE_SNAPSHOT_PREFETCH_STRIDE (BINARY_TREE_SNAPSHOT_ALIGNMENT / sizeof(int))
+
+#if defined(__GNUC__)
+#define BINARY_TREE_SNAPSHOT_PREFETCH(address) __builtin_prefetch(address)
+#define BINARY_TREE_SNAPSHOT_TRAILING_ONES(index) ((size_t) __builtin_ctzll(~(unsigned long long) (index)))
+#else
+#define BINARY_TREE_SNAPSHOT_PREFETCH(address)
+#define BINARY_TREE_SNAPSHOT_TRAILING_ONES(index) binary_tree_snapshot_trailing_ones(index)
+#endif
+
+// DATA STRUCTURES
+
+/// values[0] is unused, the root is at values[1] and the last value at values[size]
+typedef struct binary_tree_snapshot {
+    size_t size;
+    int *values;
+} BinaryTreeSnapshot;
+
+// CONSTRUCTORS AND DESTRUCTORS
+
+/// Destroys a snapshot
+/// \param snapshot The snapshot to destroy
+/// \return A NULL pointer to clean up the snapshot pointer
+BinaryTreeSnapshot *destroy_binary_tree_snapshot(BinaryTreeSnapshot *snapshot) {
+    free(snapshot);
+    return NULL;
+}
+
+/// Creates a snapshot of the values a tree holds right now. Header and values are a single allocation with the root
+/// starting a cache line
+/// \param tree The tree to copy
+/// \return A pointer to the snapshot or NULL in case of memory error
+BinaryTreeSnapshot *binary_tree_freeze(BinaryTree *tree) {
+    const size_t size = binary_tree_node_size(tree->root);
+    if (size > (SIZE_MAX - sizeof(BinaryTreeSnapshot) - 2 * BINARY_TREE_SNAPSHOT_ALIGNMENT) / sizeof(int) - 1) {
+        return NULL;
+    }
+
+    BinaryTreeSnapshot *result = malloc(sizeof(BinaryTreeSnapshot) + 2 * BINARY_TREE_SNAPSHOT_ALIGNMENT
+                                        + (size + 1) * sizeof(int));
+    if (result == NULL) {
+        perror("Could not allocate memory!");
+        return NULL;
+    }
+
+    // Place values[1] on a cache line boundary, values[0] lies in front of it
+    uintptr_t root = (uintptr_t) (result + 1) + sizeof(int);
+    root = (root + BINARY_TREE_SNAPSHOT_ALIGNMENT - 1) & ~(uintptr_t) (BINARY_TREE_SNAPSHOT_ALIGNMENT - 1);
+    result->values = (int *) root - 1;
+    result->size = size;
+    result->values[0] = 0;
+
+    if (size == 0) {
+        return result;
+    }
+
+    // Visit the Eytzinger indices in sorted order, which is the in-order walk of the implicit tree, while walking the
+    // pointer tree in order as well
+    BinaryTreeNode *node = leftmost_node_of_(tree->root);
+    size_t index = 1;
+    while (2 * index <= size) {
+        index *= 2;
+    }
+
+    for (;;) {
+        result->values[index] = node->value;
+        node = binary_tree_node_next(node);
+        if (node == NULL) {
+            break;
+        }
+
+        if (2 * index + 1 <= size) {
+            // Continue with the leftmost index of the right subtree
+            index = 2 * index + 1;
+            while (2 * index <= size) {
+                index *= 2;
+            }
+        } else {
+            // Climb while coming from a right child, then once more to the first ancestor not visited yet
+            while (index & 1) {
+                index >>= 1;
+            }
+            index >>= 1;
         }
     }
-    return NULL;
+
+    return result;
+}
+
+// FUNCTIONS
+
+/// Counts the trailing one bits of an index, for compilers without a bit scan builtin
+size_t binary_tree_snapshot_trailing_ones(size_t index) {
+    size_t count = 0;
+    while (index & 1) {
+        index >>= 1;
+        ++count;
+    }
+    return count;
 }
 
-/// Checks if a given value is in a tree
-/// \param tree The tree in which to search
-/// \param value The value to search for
-/// \return A pointer to the found node or NULL if the value is not found
-TreeNode *search_in_tree(Tree *tree, int value) {
-    return search_in_tree_internal(tree->root, value);
+/// Finds the index of the smallest value which is at least as big as value. The loop has no data dependent branches,
+/// so its length only depends on the size of the snapshot
+/// \param snapshot The snapshot to search in
+/// \param value The value to search
+/// \return The index into snapshot->values or 0 if all values are smaller
+size_t binary_tree_snapshot_lower_bound(const BinaryTreeSnapshot *snapshot, int value) {
+    const int *values = snapshot->values;
+    const size_t size = snapshot->size;
+    size_t index = 1;
+
+    while (index <= size) {
+        // The address is computed as an integer since it may lie past the end, prefetching it never faults
+        uintptr_t ahead = (uintptr_t) values + index * BINARY_TREE_SNAPSHOT_PREFETCH_STRIDE * sizeof(int);
+        BINARY_TREE_SNAPSHOT_PREFETCH((const void *) ahead);
+        index = 2 * index + (values[index] < value);
+    }
+
+    // Every step to the right appended a 1, the last step to the left ended at the result
+    return index >> (BINARY_TREE_SNAPSHOT_TRAILING_ONES(index) + 1);
+}
+
+/// Checks whether the snapshot holds a value
+/// \param snapshot The snapshot to search in
+/// \param value The value to search
+/// \return 1 if the value was found, else 0
+int binary_tree_snapshot_contains(const BinaryTreeSnapshot *snapshot, int value) {
+    size_t index = binary_tree_snapshot_lower_bound(snapshot, value);
+    return index != 0 && snapshot->values[index] == value;
 }
 
 
-/* ### BINARY TREE ###
+/* ### COMPACT BINARY TREE ###
  *
- * This is separate from Tree since it includes tracking the parent element and removal
+ * A plain Binary Tree whose nodes live in one growable array and link to each other with 32-bit indices instead of
+ * pointers. A node takes 16 bytes instead of the 40 of a BinaryTreeNode, consecutive insertions end up next to each
+ * other in memory, and since no node holds an address the whole tree can be moved, written to a file and read back
+ * as it is. Destroying the tree frees a single block.
  *
+ * Slots of deleted nodes are chained into a free list through their left index and reused by later insertions.
+ * Duplicates and deletions behave like in the plain Binary Tree.
  * */
 
 
-// DATA STRUCTURES
+#define COMPACT_BINARY_TREE_NIL UINT32_MAX
+#define COMPACT_BINARY_TREE_MINIMUM_CAPACITY 16
 
-typedef struct binary_tree_node BinaryTreeNode;
+// DATA STRUCTURES
 
-struct binary_tree_node {
+typedef struct compact_binary_tree_node {
     int value;
-    BinaryTreeNode *left;
-    BinaryTreeNode *right;
-    BinaryTreeNode *parent;
-};
-
-typedef struct binary_tree {
-    BinaryTreeNode *root;
-} BinaryTree;
+    uint32_t left;
+    uint32_t right;
+    uint32_t parent;
+} CompactBinaryTreeNode;
+
+/// length is the amount of slots ever used, count the amount of nodes in the tree. Empty links are
+/// COMPACT_BINARY_TREE_NIL
+typedef struct compact_binary_tree {
+    CompactBinaryTreeNode *nodes;
+    uint32_t root;
+    uint32_t free_list;
+    uint32_t length;
+    uint32_t capacity;
+    uint32_t count;
+} CompactBinaryTree;
 
 // CONSTRUCTORS AND DESTRUCTORS
 
-/// Creates a new binary tree node
-/// \param value The value of the new node
-/// \return A pointer to the new node or NULL in case of memory error
-BinaryTreeNode *create_binary_tree_node(int value) {
-
-    BinaryTreeNode *result = malloc(sizeof(BinaryTreeNode));
-    if (result == NULL) {
+/// Creates an empty compact binary tree
+/// \param capacity The amount of nodes to reserve space for
+/// \return A pointer to the tree or NULL in case of memory error
+CompactBinaryTree *create_compact_binary_tree(size_t capacity) {
+    if (capacity >= COMPACT_BINARY_TREE_NIL) {
         return NULL;
     }
+    if (capacity < COMPACT_BINARY_TREE_MINIMUM_CAPACITY) {
+        capacity = COMPACT_BINARY_TREE_MINIMUM_CAPACITY;
+    }
 
-    result->left = NULL;
-    result->right = NULL;
-    result->parent = NULL;
-    result->value = value;
+    CompactBinaryTree *result = malloc(sizeof(CompactBinaryTree));
+    CompactBinaryTreeNode *nodes = malloc(capacity * sizeof(CompactBinaryTreeNode));
+    if (result == NULL || nodes == NULL) {
+        perror("Could not allocate memory!");
+        free(result);
+        free(nodes);
+        return NULL;
+    }
 
+    result->nodes = nodes;
+    result->root = COMPACT_BINARY_TREE_NIL;
+    result->free_list = COMPACT_BINARY_TREE_NIL;
+    result->length = 0;
+    result->capacity = (uint32_t) capacity;
+    result->count = 0;
     return result;
 }
 
-BinaryTreeNode *destroy_binary_tree_node(BinaryTreeNode *node) {
-    if (node) {
-        if (node->parent) {
-            if (node->parent->left == node) {
-                node->parent->left = NULL;
-            } else {
-                node->parent->right = NULL;
-            }
-        }
+/// Destroys the tree and all of its nodes at once
+/// \param tree The tree to destroy
+/// \return A NULL pointer to clean up the tree pointer
+CompactBinaryTree *destroy_compact_binary_tree(CompactBinaryTree *tree) {
+    if (tree) {
+        free(tree->nodes);
     }
-    free(node);
+    free(tree);
     return NULL;
 }
 
-BinaryTreeNode *destroy_binary_tree_nodes_recursively(BinaryTreeNode *node) {
-    if (node) {
-        node->left = destroy_binary_tree_nodes_recursively(node->left);
-        node->right = destroy_binary_tree_nodes_recursively(node->right);
-    }
-    free(node);
-    return NULL;
-}
+/// Takes a slot from the free list or the end of the array, doubling the array if it is full
+/// \param tree The tree
+/// \param value The value of the new node
+/// \param parent The index of the parent node
+/// \return The index of the new node or COMPACT_BINARY_TREE_NIL in case of memory error
+uint32_t compact_binary_tree_node_create(CompactBinaryTree *tree, int value, uint32_t parent) {
+    uint32_t index = tree->free_list;
 
-BinaryTree *create_binary_tree() {
+    if (index != COMPACT_BINARY_TREE_NIL) {
+        tree->free_list = tree->nodes[index].left;
+    } else {
+        if (tree->length == tree->capacity) {
+            uint32_t capacity = tree->capacity <= (COMPACT_BINARY_TREE_NIL - 1) / 2
+                                ? 2 * tree->capacity : COMPACT_BINARY_TREE_NIL - 1;
+            if (capacity == tree->capacity) {
+                return COMPACT_BINARY_TREE_NIL;
+            }
 
-    BinaryTree *result = malloc(sizeof(BinaryTree));
-    if (result == NULL) {
-        return NULL;
+            CompactBinaryTreeNode *nodes = realloc(tree->nodes, (size_t) capacity * sizeof(CompactBinaryTreeNode));
+            if (nodes == NULL) {
+                perror("Could not allocate memory!");
+                return COMPACT_BINARY_TREE_NIL;
+            }
+            tree->nodes = nodes;
+            tree->capacity = capacity;
+        }
+        index = tree->length++;
     }
 
-    result->root = NULL;
-    return result;
+    CompactBinaryTreeNode *node = &tree->nodes[index];
+    node->value = value;
+    node->left = COMPACT_BINARY_TREE_NIL;
+    node->right = COMPACT_BINARY_TREE_NIL;
+    node->parent = parent;
+    ++tree->count;
+    return index;
 }
 
-BinaryTree *destroy_binary_tree(BinaryTree *tree) {
-    if (tree) {
-        tree->root = destroy_binary_tree_nodes_recursively(tree->root);
+/// Unlinks a leaf from its parent and puts its slot on the free list
+/// \param tree The tree
+/// \param index The index of the leaf
+void compact_binary_tree_node_destroy(CompactBinaryTree *tree, uint32_t index) {
+    uint32_t parent = tree->nodes[index].parent;
+
+    if (parent == COMPACT_BINARY_TREE_NIL) {
+        tree->root = COMPACT_BINARY_TREE_NIL;
+    } else if (tree->nodes[parent].left == index) {
+        tree->nodes[parent].left = COMPACT_BINARY_TREE_NIL;
+    } else {
+        tree->nodes[parent].right = COMPACT_BINARY_TREE_NIL;
     }
-    free(tree);
-    return NULL;
+
+    tree->nodes[index].left = tree->free_list;
+    tree->free_list = index;
+    --tree->count;
 }
 
 // FUNCTIONS
 
-/// Adds a new node with give value to the tree
-/// \param node The node at which the insertion starts
+/// Adds a new value to the tree
+/// \param tree The tree to extend
 /// \param value The value to insert
 /// \return 0 if successful, else 1 in case of memory error
-int add_to_binary_tree_internal(BinaryTreeNode *node, int value) {
+int compact_binary_tree_add(CompactBinaryTree *tree, int value) {
+    if (tree->root == COMPACT_BINARY_TREE_NIL) {
+        tree->root = compact_binary_tree_node_create(tree, value, COMPACT_BINARY_TREE_NIL);
+        return tree->root == COMPACT_BINARY_TREE_NIL;
+    }
 
-    if (node) {
-        if (node->value >= value) {
-            if (node->left) {
-                add_to_binary_tree_internal(node->left, value);
-            } else {
-                node->left = create_binary_tree_node(value);
-                if (node->left == NULL) {
-                    return 1;
-                }
-                node->left->parent = node;
-            }
-        } else {
-            if (node->right) {
-                add_to_binary_tree_internal(node->right, value);
-            } else {
-                node->right = create_binary_tree_node(value);
-                if (node->right == NULL) {
-                    return 1;
-                }
-                node->right->parent = node;
-            }
+    // Walk down to the empty slot first, creating the node may move the array
+    uint32_t parent = tree->root;
+    for (;;) {
+        uint32_t child = tree->nodes[parent].value >= value ? tree->nodes[parent].left : tree->nodes[parent].right;
+        if (child == COMPACT_BINARY_TREE_NIL) {
+            break;
         }
+        parent = child;
     }
-    return 0;
-}
 
-/// Adds a new value to the tree and creates a root node if the tree is empty
-/// \param tree The tree to extend
-/// \param value The value to insert
-/// \return 0 if successful, else 1 in case of memory error
-int add_to_binary_tree(BinaryTree *tree, int value) {
-    if (tree->root == NULL) {
-        tree->root = create_binary_tree_node(value);
-        if (tree->root == NULL) {
-            return 1;
-        }
+    uint32_t index = compact_binary_tree_node_create(tree, value, parent);
+    if (index == COMPACT_BINARY_TREE_NIL) {
+        return 1;
+    }
+
+    if (tree->nodes[parent].value >= value) {
+        tree->nodes[parent].left = index;
     } else {
-        if (add_to_binary_tree_internal(tree->root, value)) {
-            return 1;
-        }
+        tree->nodes[parent].right = index;
     }
     return 0;
 }
 
-/// Prints all the nodes recursively, indenting them for better readability
-/// \param node The subtree which is printed
-/// \param depth The depth of indentation. This parameter is used in recursion and should remain 1
-void print_binary_tree_nodes(BinaryTreeNode *node, size_t depth){
-    if (node) {
-        if (node->left) {
-            print_binary_tree_nodes(node->left, depth + 1);
-        }
-
-        for (size_t indentations = 1; indentations < depth; indentations++) {
-            printf("\t");
-        }
+/// Searches a value inside the tree
+/// \param tree The tree to search in
+/// \param value The value to search
+/// \return The index of a node holding the value or COMPACT_BINARY_TREE_NIL if the tree doesn't contain the value
+uint32_t compact_binary_tree_search(const CompactBinaryTree *tree, int value) {
+    uint32_t index = tree->root;
+    while (index != COMPACT_BINARY_TREE_NIL && tree->nodes[index].value != value) {
+        index = value < tree->nodes[index].value ? tree->nodes[index].left : tree->nodes[index].right;
+    }
+    return index;
+}
 
-        printf("%d\n", node->value);
+/// Returns the leftmost node of a subtree
+/// \param tree The tree
+/// \param index The root of the subtree
+/// \return The index of the leftmost node
+uint32_t compact_binary_tree_leftmost(const CompactBinaryTree *tree, uint32_t index) {
+    while (tree->nodes[index].left != COMPACT_BINARY_TREE_NIL) {
+        index = tree->nodes[index].left;
+    }
+    return index;
+}
 
-        if (node->right) {
-            print_binary_tree_nodes(node->right, depth + 1);
-        }
+/// Returns the rightmost node of a subtree
+/// \param tree The tree
+/// \param index The root of the subtree
+/// \return The index of the rightmost node
+uint32_t compact_binary_tree_rightmost(const CompactBinaryTree *tree, uint32_t index) {
+    while (tree->nodes[index].right != COMPACT_BINARY_TREE_NIL) {
+        index = tree->nodes[index].right;
     }
+    return index;
 }
 
-/// Prints all the nodes of the tree recursively, indenting them for better readability
-/// \param tree The tree to print
-void print_binary_tree(BinaryTree *tree) {
-    print_binary_tree_nodes(tree->root, 1);
-    printf("\n");
+/// Returns the node holding the smallest value, to start an in-order walk with compact_binary_tree_next
+/// \param tree The tree
+/// \return The index of the node or COMPACT_BINARY_TREE_NIL if the tree is empty
+uint32_t compact_binary_tree_first(const CompactBinaryTree *tree) {
+    return tree->root == COMPACT_BINARY_TREE_NIL ? COMPACT_BINARY_TREE_NIL
+                                                 : compact_binary_tree_leftmost(tree, tree->root);
 }
 
-/// Searches a value inside a subtree and fetches the respective node if found
-/// \param node The subtree to search in
-/// \param value The value to search
-/// \return A pointer to the containing BinaryTreeNode or NULL, if the subtree doesn't contain the value
-BinaryTreeNode *search_in_binary_tree_internal(BinaryTreeNode *node, int value) {
+/// Returns the in-order successor of a node by following the parent indices
+/// \param tree The tree
+/// \param index The node to start at
+/// \return The index of the node holding the next value or COMPACT_BINARY_TREE_NIL if index holds the last one
+uint32_t compact_binary_tree_next(const CompactBinaryTree *tree, uint32_t index) {
+    if (tree->nodes[index].right != COMPACT_BINARY_TREE_NIL) {
+        return compact_binary_tree_leftmost(tree, tree->nodes[index].right);
+    }
 
-    if (node) {
-        if (node->value == value) {
-            return node;
-        } else if (value < node->value) {
-            return search_in_binary_tree_internal(node->left, value);
+    uint32_t parent = tree->nodes[index].parent;
+    while (parent != COMPACT_BINARY_TREE_NIL && tree->nodes[parent].right == index) {
+        index = parent;
+        parent = tree->nodes[index].parent;
+    }
+    return parent;
+}
+
+/// Deletes a node holding value, moving values of in-order neighbours up until a leaf can be removed
+/// \param tree The tree to delete from
+/// \param value The value of the node to be deleted
+/// \return 0 if the node was successfully deleted, else 1 if the given value was not in the tree
+int compact_binary_tree_delete(CompactBinaryTree *tree, int value) {
+    uint32_t target = compact_binary_tree_search(tree, value);
+    if (target == COMPACT_BINARY_TREE_NIL) {
+        return 1;
+    }
+
+    for (;;) {
+        CompactBinaryTreeNode *node = &tree->nodes[target];
+        uint32_t replacement;
+        if (node->left != COMPACT_BINARY_TREE_NIL) {
+            replacement = compact_binary_tree_rightmost(tree, node->left);
+        } else if (node->right != COMPACT_BINARY_TREE_NIL) {
+            replacement = compact_binary_tree_leftmost(tree, node->right);
         } else {
-            return search_in_binary_tree_internal(node->right, value);
+            break;
         }
+        node->value = tree->nodes[replacement].value;
+        target = replacement;
     }
-    return NULL;
-}
 
-/// Searches a value inside a tree and fetches the respective node if found
-/// \param tree The tree to search in
-/// \param value The value to search
-/// \return A pointer to the containing BinaryTreeNode or NULL, if the tree doesn't contain the value
-BinaryTreeNode *search_in_binary_tree(BinaryTree *tree, int value) {
-    return search_in_binary_tree_internal(tree->root, value);
+    compact_binary_tree_node_destroy(tree, target);
+    return 0;
 }
 
-/// Returns the rightmost node of a given node
-/// \param node The node from where to start searching
-/// \return The rightmost node or the node itself if it has no right node
-BinaryTreeNode *rightmost_node_of_(BinaryTreeNode *node) {
-    return node->right ? rightmost_node_of_(node->right) : node;
+/// Writes the tree to a binary file. The nodes are written as they are, so the file is only meant to be read on
+/// machines with the same byte order
+/// \param tree The tree to write
+/// \param file The file opened for writing in binary mode
+/// \return 0 if successful, else 1 in case of a write error
+int compact_binary_tree_write(const CompactBinaryTree *tree, FILE *file) {
+    uint32_t header[4] = {tree->root, tree->free_list, tree->length, tree->count};
+    if (fwrite(header, sizeof(uint32_t), 4, file) != 4) {
+        return 1;
+    }
+    return fwrite(tree->nodes, sizeof(CompactBinaryTreeNode), tree->length, file) != tree->length;
 }
 
-/// Returns the leftmost node of a given node
-/// \param node The node from where to start searching
-/// \return The leftmost node or the node itself if it has no left node
-BinaryTreeNode *leftmost_node_of_(BinaryTreeNode *node) {
-    return node->left ? leftmost_node_of_(node->left) : node;
+/// Checks that an index read from a file is either empty or refers to one of the length slots
+int compact_binary_tree_index_valid(uint32_t index, uint32_t length) {
+    return index == COMPACT_BINARY_TREE_NIL || index < length;
 }
 
-/// Deletes the node with value from the subtree starting at node
-/// \param node The root from which to start looking
-/// \param value The value of the node to be deleted
-/// \return 0 if the node was successfully deleted, else 1 if the given value was not in the subtree
-int delete_binary_tree_node_internal(BinaryTreeNode *node, int value) {
-    BinaryTreeNode *target = search_in_binary_tree_internal(node, value);
-    if (target == NULL) {
-        return 1;
-    } else {
-        BinaryTreeNode *replacement;
-        if (!target->left && !target->right) {
-            destroy_binary_tree_node(target);
-            return 0;
-        } else {
-            replacement = target->left ? rightmost_node_of_(target->left) : leftmost_node_of_(target->right);
-        }
-        if (!replacement->right && !replacement->left) {
-            target->value = replacement->value;
-            destroy_binary_tree_node(replacement);
-        } else {
-            target->value = replacement->value;
-            delete_binary_tree_node_internal(replacement, replacement->value);
-        }
+/// Checks that the links of a tree whose indices are all in range form a tree below root, with matching parent
+/// indices, and that the free list chains exactly the remaining slots, so no walk over the tree can loop forever
+/// \param tree The tree
+/// \return 1 if the tree is consistent, else 0, also in case of memory error
+int compact_binary_tree_consistent(const CompactBinaryTree *tree) {
+    unsigned char *reached = calloc(tree->length ? tree->length : 1, 1);
+    uint32_t *stack = malloc((tree->length ? tree->length : 1) * sizeof(uint32_t));
+    if (reached == NULL || stack == NULL) {
+        perror("Could not allocate memory!");
+        free(reached);
+        free(stack);
         return 0;
     }
+
+    int result = 1;
+    uint32_t count = 0, depth = 0;
+    if (tree->root != COMPACT_BINARY_TREE_NIL) {
+        result = tree->nodes[tree->root].parent == COMPACT_BINARY_TREE_NIL;
+        reached[tree->root] = 1;
+        stack[depth++] = tree->root;
+    }
+    while (depth && result) {
+        uint32_t index = stack[--depth];
+        uint32_t children[2] = {tree->nodes[index].left, tree->nodes[index].right};
+        ++count;
+
+        for (int i = 0; i < 2 && result; ++i) {
+            if (children[i] != COMPACT_BINARY_TREE_NIL) {
+                result = !reached[children[i]] && tree->nodes[children[i]].parent == index;
+                reached[children[i]] = 1;
+                stack[depth++] = children[i];
+            }
+        }
+    }
+    result = result && count == tree->count;
+
+    uint32_t index = tree->free_list;
+    while (index != COMPACT_BINARY_TREE_NIL && result) {
+        result = !reached[index];
+        reached[index] = 1;
+        ++count;
+        index = tree->nodes[index].left;
+    }
+    result = result && count == tree->length;
+
+    free(reached);
+    free(stack);
+    return result;
 }
 
-int delete_binary_tree_node(BinaryTree *tree, int value) {
-    return delete_binary_tree_node_internal(tree->root, value);
+/// Reads a tree written by compact_binary_tree_write. Every index is checked to be in range and the links to be
+/// consistent, so a truncated or corrupted file can't make later operations leave the nodes or loop forever
+/// \param file The file opened for reading in binary mode
+/// \return A pointer to the tree or NULL in case of a read or memory error or if the file holds an invalid tree
+CompactBinaryTree *compact_binary_tree_read(FILE *file) {
+    uint32_t header[4];
+    if (fread(header, sizeof(uint32_t), 4, file) != 4 || header[2] == COMPACT_BINARY_TREE_NIL) {
+        return NULL;
+    }
+
+    CompactBinaryTree *result = create_compact_binary_tree(header[2]);
+    if (result == NULL) {
+        return NULL;
+    }
+    if (fread(result->nodes, sizeof(CompactBinaryTreeNode), header[2], file) != header[2]) {
+        return destroy_compact_binary_tree(result);
+    }
+
+    if (!compact_binary_tree_index_valid(header[0], header[2]) || !compact_binary_tree_index_valid(header[1], header[2])
+        || header[3] > header[2]) {
+        return destroy_compact_binary_tree(result);
+    }
+    for (uint32_t i = 0; i < header[2]; ++i) {
+        const CompactBinaryTreeNode *node = &result->nodes[i];
+        if (!compact_binary_tree_index_valid(node->left, header[2])
+            || !compact_binary_tree_index_valid(node->right, header[2])
+            || !compact_binary_tree_index_valid(node->parent, header[2])) {
+            return destroy_compact_binary_tree(result);
+        }
+    }
+
+    result->root = header[0];
+    result->free_list = header[1];
+    result->length = header[2];
+    result->count = header[3];
+    return compact_binary_tree_consistent(result) ? result : destroy_compact_binary_tree(result);
 }
 
 
@@ -807,9 +2467,11 @@ int delete_binary_tree_node(BinaryTree *tree, int value) {
 
 typedef struct alnode AdjacencyListNode;
 
-/// An adjacency node contains a value and a dynamic list with its predecessors
+/// An adjacency node contains a value, a dynamic list with its successors and the amount of its predecessors, which
+/// is kept up to date by link_alnodes(). The out-degree is the length of successors
 struct alnode {
     int value;
+    size_t in_degree;
     LinkedList *successors;
 };
 
@@ -842,6 +2504,7 @@ AdjacencyListNode *adjacency_list_node_create(int value) {
     }
 
     result->value = value;
+    result->in_degree = 0;
 
     result->successors = linked_list_create();
     if (result->successors == NULL) {
@@ -897,18 +2560,101 @@ AdjacencyList *adjacency_list_create(size_t size) {
 /// \param from The node from wich the edge starts
 /// \param to The node to which the edge goes
 void link_alnodes(AdjacencyListNode *from, AdjacencyListNode *to) {
-    if (from && to && !linked_list_contains(from->successors, to->value)) {
-        linked_list_add(from->successors, to->value);
+    if (from && to && !linked_list_contains(from->successors, to->value)
+        && linked_list_insert(from->successors, to->value, from->successors->length) == 0) {
+        ++to->in_degree;
     }
 }
 
+/// Returns the amount of edges leading to a node in O(1)
+/// \param node The node
+/// \param graph The list the node belongs to
+/// \return The in-degree of node
 size_t indeg(AdjacencyListNode *node, AdjacencyList *graph) {
-    size_t result = 0;
-    for (size_t i = 0; i < graph->size; ++i) {
-        if (linked_list_contains(graph->nodes[i]->successors, node->value)) {
-            ++result;
+    return node->in_degree;
+}
+
+/// Returns the amount of edges starting at a node in O(1)
+/// \param node The node
+/// \return The out-degree of node
+size_t outdeg(AdjacencyListNode *node) {
+    return node->successors->length;
+}
+
+/// Returns the in- or out-degree of a node
+size_t alnode_degree(AdjacencyListNode *node, int in) {
+    return in ? node->in_degree : node->successors->length;
+}
+
+/// Lists the nodes ordered by their in- or out-degree, highest first, in O(n + maximum degree) by counting sort.
+/// Nodes of equal degree keep their order
+/// \param list The list
+/// \param in 1 to order by in-degree, 0 to order by out-degree
+/// \param result Receives the nodes, must have room for list->size nodes
+/// \return 0 on success, 1 in case of memory error
+int adjacency_list_by_degree(const AdjacencyList *list, int in, AdjacencyListNode **result) {
+    size_t maximum = 0;
+    for (size_t i = 0; i < list->size; ++i) {
+        size_t degree = alnode_degree(list->nodes[i], in);
+        if (degree > maximum) {
+            maximum = degree;
+        }
+    }
+
+    size_t *positions = calloc(maximum + 1, sizeof(size_t));
+    if (positions == NULL) {
+        perror("Could not allocate memory!");
+        return 1;
+    }
+
+    // Count the nodes per degree, then turn the counts into the first position of every degree, starting at the top
+    for (size_t i = 0; i < list->size; ++i) {
+        ++positions[alnode_degree(list->nodes[i], in)];
+    }
+    size_t position = 0;
+    for (size_t degree = maximum + 1; degree-- > 0;) {
+        size_t count = positions[degree];
+        positions[degree] = position;
+        position += count;
+    }
+
+    for (size_t i = 0; i < list->size; ++i) {
+        result[positions[alnode_degree(list->nodes[i], in)]++] = list->nodes[i];
+    }
+
+    free(positions);
+    return 0;
+}
+
+/// Converts the list into a CSR Graph for fast traversals. Node i of the graph is nodes[i], so like in the list the
+/// successor values are the indices of the nodes
+/// \param list The list to convert
+/// \return A pointer to the graph or NULL in case of memory error or if a successor is not a node of the list
+CsrGraph *adjacency_list_to_csr(const AdjacencyList *list) {
+    size_t edge_count = 0;
+    for (size_t i = 0; i < list->size; ++i) {
+        edge_count += list->nodes[i]->successors->length;
+    }
+
+    CsrGraph *result = csr_graph_create(list->size, edge_count);
+    if (result == NULL) {
+        return NULL;
+    }
+
+    size_t edge = 0;
+    for (size_t i = 0; i < list->size; ++i) {
+        result->offsets[i] = edge;
+        result->values[i] = list->nodes[i]->value;
+
+        for (LinkedListNode *successor = list->nodes[i]->successors->head; successor; successor = successor->next) {
+            if (successor->value < 0 || (size_t) successor->value >= list->size) {
+                return csr_graph_destroy(result);
+            }
+            result->targets[edge++] = (uint32_t) successor->value;
         }
     }
+    result->offsets[list->size] = edge;
+
     return result;
 }
 
@@ -940,31 +2686,45 @@ struct b_tree_node {
     BTreeNode *parent;
 };
 
+/// If pool is set, all nodes are allocated from it
 typedef struct b_tree {
     BTreeNode *root;
+    MemoryPool *pool;
 } BTree;
 
 // CONSTRUCTORS AND DESTRUCTORS
 
-/// Destroys a node and its child nodes recursively
+/// Destroys a node and its child nodes without recursion or an extra stack
 /// \param node The node to destroy
 /// \return A NULL pointer to clean up the node pointer
 BTreeNode *b_tree_node_destroy_recursively(BTreeNode *node) {
-    if (node) {
-        for (size_t i = 0; i < node->children_count; ++i) {
-            b_tree_node_destroy_recursively(node->children[i]);
+
+    // Descend into the last child, leaving the way back in the slot it occupied. Once a node has no children left it
+    // is freed and the walk continues at the parent stored in the parent's own vacated slot
+    BTreeNode *parent = NULL;
+    while (node) {
+        if (node->children_count) {
+            BTreeNode *child = node->children[--node->children_count];
+            node->children[node->children_count] = parent;
+            parent = node;
+            node = child;
+        } else {
+            free(node);
+            node = parent;
+            if (node) {
+                parent = node->children[node->children_count];
+            }
         }
     }
-    free(node);
     return NULL;
 }
 
-/// Creates a new node of given degree
-/// \param degree The degree of the node
+/// Creates a new node of degree DEGREE
+/// \param pool The pool to allocate the node from or NULL to use malloc
 /// \return A pointer to the new node or NULL in case of memory allocation failure
-BTreeNode *b_tree_node_create() {
+BTreeNode *b_tree_node_create(MemoryPool *pool) {
 
-    BTreeNode *result = malloc(sizeof(BTreeNode));
+    BTreeNode *result = pool ? memory_pool_allocate(pool) : malloc(sizeof(BTreeNode));
     if (result == NULL) {
         return NULL;
     }
@@ -987,15 +2747,33 @@ BTree *b_tree_create() {
     }
 
     result->root = NULL;
+    result->pool = NULL;
     return result;
 }
 
-/// Destroys the tree, recursively destroying its nodes
+/// Creates a new B-tree which allocates its nodes from a pool. The tree takes ownership of the pool, so the pool must
+/// not be shared with other structures
+/// \param pool A pool with an element size of at least sizeof(BTreeNode)
+/// \return A pointer to the new tree or NULL in case of memory error
+BTree *b_tree_create_pooled(MemoryPool *pool) {
+    BTree *result = b_tree_create();
+    if (result) {
+        result->pool = pool;
+    }
+    return result;
+}
+
+/// Destroys the tree, recursively destroying its nodes. A pooled tree is released together with its pool in one step
 /// \param tree The tree to destroy
 /// \return A NULL pointer to clean up the tree pointer
 BTree *b_tree_destroy(BTree *tree) {
     if (tree) {
-        tree->root = b_tree_node_destroy_recursively(tree->root);
+        if (tree->pool) {
+            tree->pool = memory_pool_destroy(tree->pool);
+            tree->root = NULL;
+        } else {
+            tree->root = b_tree_node_destroy_recursively(tree->root);
+        }
     }
     free(tree);
     return NULL;
@@ -0,0 +1,429 @@
+#ifndef GENERIC_H
+#define GENERIC_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*
+ * Contains macros which generate typed containers, the C counterpart of templates:
+ *
+ * - Linked List
+ * - Array functions
+ * - Comparators
+ *
+ * Every instantiation gets its own functions in which the comparison of values is expanded inline, so there are no
+ * runtime type switches or void pointers involved. compare(a, b) must be a function or function-like macro returning a
+ * negative number, 0 or a positive number like strcmp. GENERIC_COMPARE works for all arithmetic and pointer types.
+ *
+ * For programs split into several translation units, the TYPES and DECLARATIONS macros go into a header and the
+ * FUNCTIONS macro into exactly one source file.
+ */
+
+
+/// Three-way comparison which does not compare floating point values for equality
+#define GENERIC_COMPARE(a, b) (((a) > (b)) - ((a) < (b)))
+
+
+/* ### LINKED LIST ###
+ *
+ * GENERATE_LINKED_LIST(List, prefix, type, compare, format) creates the types List and ListNode (struct prefix and
+ * struct prefix_node) holding values of type. The list keeps track of its last node and its length, so appending and
+ * asking for the length take constant time. If pool is set, all nodes are allocated from it, which requires
+ * memory_pool.h to be included before the FUNCTIONS macro. format is the printf format of a single value.
+ *
+ * Generated functions:
+ *
+ * - prefix_node_create(pool, value) / prefix_node_destroy(pool, node)
+ * - prefix_node_destroy_recursively(node), which frees node and all of its successors in a loop
+ * - prefix_create() / prefix_create_pooled(pool), which hands the pool over to the list / prefix_destroy(list)
+ * - prefix_get_length(list)
+ * - prefix_insert(list, value, index), returning 0 on success, 2 if index is out of range and 1 on memory error
+ * - prefix_add(list, value), which appends
+ * - prefix_add_sorted(list, value), which inserts after all values which are smaller or equal
+ * - prefix_remove(list, value), returning 0 if the first node holding value was removed, else 1
+ * - prefix_contains(list, value) / prefix_as_array(list, array) / prefix_print(list)
+ * - prefix_sort(list), a stable bottom-up merge sort which relinks the nodes in O(n log n) time and O(1) extra space
+ */
+
+
+#define GENERATE_LINKED_LIST_TYPES(List, prefix, type) \
+    typedef struct prefix##_node List##Node; \
+    \
+    struct prefix##_node { \
+        type value; \
+        List##Node *next; \
+    }; \
+    \
+    typedef struct prefix { \
+        List##Node *head; \
+        List##Node *tail; \
+        size_t length; \
+        struct memory_pool *pool; \
+    } List;
+
+#define GENERATE_LINKED_LIST_DECLARATIONS(List, prefix, type) \
+    List##Node *prefix##_node_create(struct memory_pool *pool, type value); \
+    List##Node *prefix##_node_destroy(struct memory_pool *pool, List##Node *node); \
+    List##Node *prefix##_node_destroy_recursively(List##Node *node); \
+    List *prefix##_create(); \
+    List *prefix##_create_pooled(struct memory_pool *pool); \
+    List *prefix##_destroy(List *list); \
+    size_t prefix##_get_length(const List *list); \
+    int prefix##_insert(List *list, type value, size_t index); \
+    int prefix##_add_sorted(List *list, type value); \
+    void prefix##_as_array(const List *list, type *array); \
+    void prefix##_add(List *list, type value); \
+    void prefix##_print(const List *list); \
+    int prefix##_contains(const List *list, type value); \
+    int prefix##_remove(List *list, type value); \
+    List##Node *prefix##_node_split(List##Node *node, size_t count); \
+    void prefix##_sort(List *list);
+
+#define GENERATE_LINKED_LIST_FUNCTIONS(List, prefix, type, compare, format) \
+    List##Node *prefix##_node_create(struct memory_pool *pool, type value) { \
+        List##Node *result = pool ? memory_pool_allocate(pool) : malloc(sizeof(List##Node)); \
+        if (result == NULL) { \
+            perror("Could not allocate memory!"); \
+            return NULL; \
+        } \
+        \
+        result->value = value; \
+        result->next = NULL; \
+        \
+        return result; \
+    } \
+    \
+    List##Node *prefix##_node_destroy(struct memory_pool *pool, List##Node *node) { \
+        if (pool) { \
+            memory_pool_free(pool, node); \
+        } else { \
+            free(node); \
+        } \
+        return NULL; \
+    } \
+    \
+    List##Node *prefix##_node_destroy_recursively(List##Node *node) { \
+        while (node) { \
+            List##Node *next = node->next; \
+            free(node); \
+            node = next; \
+        } \
+        return NULL; \
+    } \
+    \
+    List *prefix##_create() { \
+        return calloc(1, sizeof(List)); \
+    } \
+    \
+    List *prefix##_create_pooled(struct memory_pool *pool) { \
+        List *result = prefix##_create(); \
+        if (result) { \
+            result->pool = pool; \
+        } \
+        return result; \
+    } \
+    \
+    List *prefix##_destroy(List *list) { \
+        if (list) { \
+            if (list->pool) { \
+                list->pool = memory_pool_destroy(list->pool); \
+                list->head = NULL; \
+            } else { \
+                list->head = prefix##_node_destroy_recursively(list->head); \
+            } \
+            list->tail = NULL; \
+            list->length = 0; \
+        } \
+        free(list); \
+        return NULL; \
+    } \
+    \
+    size_t prefix##_get_length(const List *list) { \
+        return list ? list->length : 0; \
+    } \
+    \
+    int prefix##_insert(List *list, type value, size_t index) { \
+        \
+        /* Catch index out of range */ \
+        if (index > list->length) { \
+            perror("List index out of range!"); \
+            return 2; \
+        } \
+        \
+        List##Node *head = list->head; \
+        List##Node *to_insert = prefix##_node_create(list->pool, value); \
+        if (to_insert == NULL) { \
+            return 1; \
+        } \
+        \
+        /* Catch append to front case */ \
+        /* Catch append to end case, which needs no traversal thanks to the tail */ \
+        /* Else insert normally */ \
+        if (index == 0) { \
+            to_insert->next = head; \
+            list->head = to_insert; \
+            if (list->tail == NULL) { \
+                list->tail = to_insert; \
+            } \
+        } else if (index == list->length) { \
+            list->tail->next = to_insert; \
+            list->tail = to_insert; \
+        } else { \
+            List##Node *before = head; \
+            \
+            for (size_t i = 0; i < index; ++i) { \
+                before = head; \
+                head = head->next; \
+            } \
+            \
+            before->next = to_insert; \
+            to_insert->next = head; \
+        } \
+        \
+        ++list->length; \
+        return 0; \
+    } \
+    \
+    int prefix##_add_sorted(List *list, type value) { \
+        \
+        List##Node *to_insert = prefix##_node_create(list->pool, value); \
+        if (to_insert == NULL) { \
+            return 1; \
+        } \
+        \
+        List##Node *current_node = list->head; \
+        \
+        /* Catch empty list and append to front case */ \
+        /* Catch append to end case, where the value is at least as large as the last one */ \
+        if (current_node == NULL || compare(current_node->value, value) > 0) { \
+            to_insert->next = current_node; \
+            list->head = to_insert; \
+            if (list->tail == NULL) { \
+                list->tail = to_insert; \
+            } \
+        } else if (compare(list->tail->value, value) <= 0) { \
+            list->tail->next = to_insert; \
+            list->tail = to_insert; \
+        } else { \
+            List##Node *precursor = current_node; \
+            \
+            /* The tail is larger than our value, so we are guaranteed to find a larger node before the end */ \
+            while (compare(precursor->next->value, value) <= 0) { \
+                precursor = precursor->next; \
+            } \
+            \
+            to_insert->next = precursor->next; \
+            precursor->next = to_insert; \
+        } \
+        \
+        ++list->length; \
+        return 0; \
+    } \
+    \
+    void prefix##_as_array(const List *list, type *array) { \
+        \
+        List##Node *node = list->head; \
+        \
+        for (size_t i = 0; i < list->length; ++i) { \
+            array[i] = node->value; \
+            node = node->next; \
+        } \
+    } \
+    \
+    void prefix##_add(List *list, type value) { \
+        prefix##_insert(list, value, list->length); \
+    } \
+    \
+    void prefix##_print(const List *list) { \
+        if (list) { \
+            List##Node *head = list->head; \
+            \
+            while (head != NULL) { \
+                printf(format, head->value); \
+                head = head->next; \
+            } \
+            \
+            printf("\n"); \
+        } \
+    } \
+    \
+    int prefix##_contains(const List *list, type value) { \
+        if (list) { \
+            List##Node *current = list->head; \
+            while (current) { \
+                if (compare(current->value, value) == 0) { \
+                    return 1; \
+                } \
+                current = current->next; \
+            } \
+        } \
+        return 0; \
+    } \
+    \
+    int prefix##_remove(List *list, type value) { \
+        List##Node *current = list->head; \
+        List##Node *last = NULL; \
+        \
+        while (current) { \
+            if (compare(current->value, value) == 0) { \
+                if (last == NULL) { \
+                    list->head = current->next; \
+                } else { \
+                    last->next = current->next; \
+                } \
+                \
+                /* Removing the last node makes its precursor the new tail */ \
+                if (current == list->tail) { \
+                    list->tail = last; \
+                } \
+                \
+                prefix##_node_destroy(list->pool, current); \
+                --list->length; \
+                return 0; \
+            } \
+            last = current; \
+            current = current->next; \
+        } \
+        return 1; \
+    } \
+    \
+    /* Cuts the chain after count nodes and returns the first node of the rest */ \
+    List##Node *prefix##_node_split(List##Node *node, size_t count) { \
+        for (size_t i = 1; node && i < count; ++i) { \
+            node = node->next; \
+        } \
+        if (node == NULL) { \
+            return NULL; \
+        } \
+        \
+        List##Node *rest = node->next; \
+        node->next = NULL; \
+        return rest; \
+    } \
+    \
+    void prefix##_sort(List *list) { \
+        List##Node *last = list->tail; \
+        \
+        /* Merge neighbouring sorted runs of width nodes, doubling width until one run spans the list */ \
+        for (size_t width = 1; width < list->length; width *= 2) { \
+            List##Node *remaining = list->head; \
+            List##Node **link = &list->head; \
+            \
+            while (remaining) { \
+                List##Node *left = remaining; \
+                List##Node *right = prefix##_node_split(left, width); \
+                remaining = prefix##_node_split(right, width); \
+                \
+                /* Taking from the left run on ties keeps the sort stable */ \
+                while (left && right) { \
+                    if (compare(left->value, right->value) <= 0) { \
+                        *link = left; \
+                        left = left->next; \
+                    } else { \
+                        *link = right; \
+                        right = right->next; \
+                    } \
+                    link = &(*link)->next; \
+                } \
+                \
+                /* Append what is left of either run and move on to its end */ \
+                *link = left ? left : right; \
+                while (*link) { \
+                    last = *link; \
+                    link = &last->next; \
+                } \
+            } \
+        } \
+        \
+        list->tail = last; \
+    }
+
+#define GENERATE_LINKED_LIST(List, prefix, type, compare, format) \
+    GENERATE_LINKED_LIST_TYPES(List, prefix, type) \
+    GENERATE_LINKED_LIST_FUNCTIONS(List, prefix, type, compare, format)
+
+
+/* ### ARRAY FUNCTIONS ###
+ *
+ * GENERATE_ARRAY_FUNCTIONS(prefix, type, compare) creates functions working on plain arrays of type whose size is
+ * tracked by the caller. Functions which change the size update it through the size pointer. Insertions assume that
+ * the array can fit an additional value.
+ *
+ * Generated functions:
+ *
+ * - prefix_get_index(array, size, value), returning the index of the first occurrence or size if there is none
+ * - prefix_contains(array, size, value)
+ * - prefix_insert(array, &size, index, value) / prefix_add(array, &size, value), which appends
+ * - prefix_add_sorted(array, &size, value), which inserts after all values which are smaller or equal
+ * - prefix_delete(array, &size, value), returning 0 if the first occurrence was removed, else 1
+ */
+
+
+#define GENERATE_ARRAY_DECLARATIONS(prefix, type) \
+    size_t prefix##_get_index(type const *array, size_t size, type value); \
+    int prefix##_contains(type const *array, size_t size, type value); \
+    void prefix##_insert(type *array, size_t *size, size_t index, type value); \
+    void prefix##_add(type *array, size_t *size, type value); \
+    void prefix##_add_sorted(type *array, size_t *size, type value); \
+    int prefix##_delete(type *array, size_t *size, type value);
+
+#define GENERATE_ARRAY_FUNCTIONS(prefix, type, compare) \
+    size_t prefix##_get_index(type const *array, size_t size, type value) { \
+        for (size_t i = 0; i < size; ++i) { \
+            if (compare(array[i], value) == 0) { \
+                return i; \
+            } \
+        } \
+        return size; \
+    } \
+    \
+    int prefix##_contains(type const *array, size_t size, type value) { \
+        return prefix##_get_index(array, size, value) != size; \
+    } \
+    \
+    void prefix##_insert(type *array, size_t *size, size_t index, type value) { \
+        memmove(array + index + 1, array + index, (*size - index) * sizeof(type)); \
+        array[index] = value; \
+        ++*size; \
+    } \
+    \
+    void prefix##_add(type *array, size_t *size, type value) { \
+        array[*size] = value; \
+        ++*size; \
+    } \
+    \
+    void prefix##_add_sorted(type *array, size_t *size, type value) { \
+        size_t index = *size; \
+        while (index > 0 && compare(array[index - 1], value) > 0) { \
+            --index; \
+        } \
+        prefix##_insert(array, size, index, value); \
+    } \
+    \
+    int prefix##_delete(type *array, size_t *size, type value) { \
+        size_t index = prefix##_get_index(array, *size, value); \
+        if (index == *size) { \
+            return 1; \
+        } \
+        \
+        memmove(array + index, array + index + 1, (*size - index - 1) * sizeof(type)); \
+        --*size; \
+        return 0; \
+    }
+
+
+/* ### COMPARATORS ###
+ *
+ * GENERATE_COMPARATOR(name, type, compare) creates int name(const void *, const void *) for use with qsort and bsearch
+ */
+
+
+#define GENERATE_COMPARATOR(name, type, compare) \
+    int name(const void *first, const void *second) { \
+        type a = *(type const *) first; \
+        type b = *(type const *) second; \
+        return compare(a, b); \
+    }
+
+#endif
@@ -0,0 +1,352 @@
+#ifndef LOCK_FREE_LIST_H
+#define LOCK_FREE_LIST_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+
+/*
+ * LOCK-FREE LINKED LIST
+ *
+ * A sorted set of ints which any number of threads may modify and query at the same time without locking, following
+ * Harris' design: a node is removed by first marking the lowest bit of its next pointer (logical deletion) and then
+ * unlinking it with a compare-and-swap. Traversals unlink marked nodes they come across.
+ *
+ * Unlinked nodes can still be in use by concurrent readers, so they are not freed right away. Epoch based reclamation
+ * decides when freeing is safe: every thread announces the global epoch when it starts an operation, and a node
+ * retired in epoch e is only freed once the global epoch reached e + 2. The epoch can only advance when every thread
+ * inside an operation has seen the current one, so no thread can still hold a pointer to such a node.
+ *
+ * Every thread registers once and passes its handle to all operations. Uses C11 atomics.
+ */
+
+
+#define LOCK_FREE_LIST_MAX_THREADS 64
+#define LOCK_FREE_LIST_EPOCHS 3
+#define LOCK_FREE_LIST_RETIRE_THRESHOLD 64
+
+// DATA STRUCTURES
+
+typedef struct lock_free_list_node LockFreeListNode;
+
+/// The lowest bit of next marks the node as deleted
+struct lock_free_list_node {
+    int value;
+    _Atomic uintptr_t next;
+    LockFreeListNode *next_retired;
+};
+
+/// The epoch state of a registered thread. state is 0 while the thread is outside of an operation, else the epoch it
+/// announced shifted left by one with the lowest bit set. The retired lists are only touched by the owning thread
+typedef struct lock_free_list_thread {
+    _Atomic size_t state;
+    _Atomic int in_use;
+    LockFreeListNode *retired[LOCK_FREE_LIST_EPOCHS];
+    size_t retired_epoch[LOCK_FREE_LIST_EPOCHS];
+    size_t retired_count;
+    char padding[64];
+} LockFreeListThread;
+
+/// The head is a sentinel node, its value is never looked at
+typedef struct lock_free_list {
+    LockFreeListNode *head;
+    _Atomic size_t epoch;
+    LockFreeListThread threads[LOCK_FREE_LIST_MAX_THREADS];
+} LockFreeList;
+
+// CONSTRUCTORS AND DESTRUCTORS
+
+/// Creates a new lock-free list node
+/// \param value The node's value
+/// \return A pointer to the new node or NULL if memory allocation failed
+LockFreeListNode *lock_free_list_node_create(int value) {
+    LockFreeListNode *result = malloc(sizeof(LockFreeListNode));
+    if (result == NULL) {
+        perror("Could not allocate memory!");
+        return NULL;
+    }
+
+    result->value = value;
+    atomic_init(&result->next, (uintptr_t) 0);
+    result->next_retired = NULL;
+
+    return result;
+}
+
+/// Frees a chain of retired nodes
+/// \param node The first node of the chain
+void lock_free_list_free_retired(LockFreeListNode *node) {
+    while (node) {
+        LockFreeListNode *next = node->next_retired;
+        free(node);
+        node = next;
+    }
+}
+
+/// Creates an empty lock-free list
+/// \return A pointer to the list or NULL if memory allocation failed
+LockFreeList *lock_free_list_create() {
+    LockFreeList *result = calloc(1, sizeof(LockFreeList));
+    if (result == NULL) {
+        return NULL;
+    }
+
+    result->head = lock_free_list_node_create(0);
+    if (result->head == NULL) {
+        free(result);
+        return NULL;
+    }
+
+    atomic_init(&result->epoch, (size_t) LOCK_FREE_LIST_EPOCHS);
+    for (size_t i = 0; i < LOCK_FREE_LIST_MAX_THREADS; ++i) {
+        atomic_init(&result->threads[i].state, (size_t) 0);
+        atomic_init(&result->threads[i].in_use, 0);
+    }
+
+    return result;
+}
+
+/// Destroys the list including all nodes still waiting for reclamation. No thread may use the list anymore
+/// \param list The list to destroy
+/// \return A NULL pointer to be used for overwriting the object pointer
+LockFreeList *lock_free_list_destroy(LockFreeList *list) {
+    if (list) {
+        LockFreeListNode *current = list->head;
+        while (current) {
+            LockFreeListNode *next = (LockFreeListNode *) (atomic_load(&current->next) & ~(uintptr_t) 1);
+            free(current);
+            current = next;
+        }
+
+        for (size_t i = 0; i < LOCK_FREE_LIST_MAX_THREADS; ++i) {
+            for (size_t j = 0; j < LOCK_FREE_LIST_EPOCHS; ++j) {
+                lock_free_list_free_retired(list->threads[i].retired[j]);
+            }
+        }
+    }
+    free(list);
+    return NULL;
+}
+
+/// Registers the calling thread with the list. Every thread needs its own handle
+/// \param list The list to use
+/// \return The thread's handle or NULL if LOCK_FREE_LIST_MAX_THREADS threads are registered already
+LockFreeListThread *lock_free_list_register(LockFreeList *list) {
+    for (size_t i = 0; i < LOCK_FREE_LIST_MAX_THREADS; ++i) {
+        int expected = 0;
+        if (atomic_compare_exchange_strong(&list->threads[i].in_use, &expected, 1)) {
+            return &list->threads[i];
+        }
+    }
+    return NULL;
+}
+
+/// Gives a thread handle back. Nodes the thread retired are reclaimed later by whoever registers next in its place,
+/// or by lock_free_list_destroy()
+/// \param thread The handle of the calling thread
+void lock_free_list_unregister(LockFreeListThread *thread) {
+    atomic_store(&thread->in_use, 0);
+}
+
+// FUNCTIONS
+
+/// Frees all retired nodes of the thread which no other thread can reach anymore
+/// \param list The list
+/// \param thread The handle of the calling thread
+/// \param epoch The current global epoch
+void lock_free_list_reclaim(LockFreeList *list, LockFreeListThread *thread, size_t epoch) {
+    for (size_t i = 0; i < LOCK_FREE_LIST_EPOCHS; ++i) {
+        if (thread->retired[i] && thread->retired_epoch[i] + 2 <= epoch) {
+            lock_free_list_free_retired(thread->retired[i]);
+            thread->retired[i] = NULL;
+        }
+    }
+}
+
+/// Starts an operation by announcing the current epoch
+/// \param list The list
+/// \param thread The handle of the calling thread
+void lock_free_list_enter(LockFreeList *list, LockFreeListThread *thread) {
+    size_t epoch = atomic_load(&list->epoch);
+    atomic_store(&thread->state, (epoch << 1) | 1);
+    lock_free_list_reclaim(list, thread, epoch);
+}
+
+/// Ends an operation. From now on the thread holds no pointers into the list
+/// \param thread The handle of the calling thread
+void lock_free_list_exit(LockFreeListThread *thread) {
+    atomic_store(&thread->state, (size_t) 0);
+}
+
+/// Advances the global epoch if every thread inside an operation has announced the current one
+/// \param list The list
+/// \return The global epoch after the attempt
+size_t lock_free_list_try_advance(LockFreeList *list) {
+    size_t epoch = atomic_load(&list->epoch);
+
+    for (size_t i = 0; i < LOCK_FREE_LIST_MAX_THREADS; ++i) {
+        size_t state = atomic_load(&list->threads[i].state);
+        if ((state & 1) && (state >> 1) != epoch) {
+            return epoch;
+        }
+    }
+
+    if (atomic_compare_exchange_strong(&list->epoch, &epoch, epoch + 1)) {
+        return epoch + 1;
+    }
+    return epoch;
+}
+
+/// Hands an unlinked node over for reclamation. The node is tagged with the epoch read after unlinking it, so every
+/// thread that may still see it announced that epoch or an earlier one
+/// \param list The list
+/// \param thread The handle of the calling thread
+/// \param node The node which was just unlinked by this thread
+void lock_free_list_retire(LockFreeList *list, LockFreeListThread *thread, LockFreeListNode *node) {
+    size_t epoch = atomic_load(&list->epoch);
+    size_t index = epoch % LOCK_FREE_LIST_EPOCHS;
+
+    // The slot of this epoch can only hold nodes from at least three epochs ago, which are safe to free
+    if (thread->retired[index] && thread->retired_epoch[index] != epoch) {
+        lock_free_list_free_retired(thread->retired[index]);
+        thread->retired[index] = NULL;
+    }
+
+    node->next_retired = thread->retired[index];
+    thread->retired[index] = node;
+    thread->retired_epoch[index] = epoch;
+
+    if (++thread->retired_count % LOCK_FREE_LIST_RETIRE_THRESHOLD == 0) {
+        lock_free_list_reclaim(list, thread, lock_free_list_try_advance(list));
+    }
+}
+
+/// Finds the position of a value, unlinking all marked nodes on the way
+/// \param list The list to search in
+/// \param thread The handle of the calling thread
+/// \param value The value to search for
+/// \param previous Will point to the link which points to the returned node
+/// \return The first unmarked node whose value is not smaller than value or NULL if there is none
+LockFreeListNode *lock_free_list_find(LockFreeList *list, LockFreeListThread *thread, int value,
+                                      _Atomic uintptr_t **previous) {
+    retry:
+    *previous = &list->head->next;
+    LockFreeListNode *current = (LockFreeListNode *) atomic_load(*previous);
+
+    while (current) {
+        uintptr_t next = atomic_load(&current->next);
+
+        // current is logically deleted, so help unlinking it. If our predecessor changed, start over
+        if (next & 1) {
+            uintptr_t expected = (uintptr_t) current;
+            if (!atomic_compare_exchange_strong(*previous, &expected, next & ~(uintptr_t) 1)) {
+                goto retry;
+            }
+            lock_free_list_retire(list, thread, current);
+            current = (LockFreeListNode *) (next & ~(uintptr_t) 1);
+            continue;
+        }
+
+        if (current->value >= value) {
+            break;
+        }
+
+        *previous = &current->next;
+        current = (LockFreeListNode *) next;
+    }
+
+    return current;
+}
+
+/// Adds a value to the set
+/// \param list The list to insert into
+/// \param thread The handle of the calling thread
+/// \param value The value to insert
+/// \return 0 if insertion was successful, 1 if memory allocation failed and 2 if the value was already contained
+int lock_free_list_add(LockFreeList *list, LockFreeListThread *thread, int value) {
+    LockFreeListNode *to_insert = lock_free_list_node_create(value);
+    if (to_insert == NULL) {
+        return 1;
+    }
+
+    lock_free_list_enter(list, thread);
+    while (true) {
+        _Atomic uintptr_t *previous;
+        LockFreeListNode *current = lock_free_list_find(list, thread, value, &previous);
+
+        if (current && current->value == value) {
+            lock_free_list_exit(thread);
+            free(to_insert);
+            return 2;
+        }
+
+        atomic_store_explicit(&to_insert->next, (uintptr_t) current, memory_order_relaxed);
+        uintptr_t expected = (uintptr_t) current;
+        if (atomic_compare_exchange_strong(previous, &expected, (uintptr_t) to_insert)) {
+            lock_free_list_exit(thread);
+            return 0;
+        }
+    }
+}
+
+/// Removes a value from the set
+/// \param list The list to remove from
+/// \param thread The handle of the calling thread
+/// \param value The value to remove
+/// \return 0 if the value was removed, else 1 if the list doesn't contain that value
+int lock_free_list_remove(LockFreeList *list, LockFreeListThread *thread, int value) {
+    lock_free_list_enter(list, thread);
+    while (true) {
+        _Atomic uintptr_t *previous;
+        LockFreeListNode *current = lock_free_list_find(list, thread, value, &previous);
+
+        if (current == NULL || current->value != value) {
+            lock_free_list_exit(thread);
+            return 1;
+        }
+
+        // Logical deletion. If it fails, the node changed under us and we look again
+        uintptr_t next = atomic_load(&current->next);
+        if (next & 1) {
+            continue;
+        }
+        if (!atomic_compare_exchange_strong(&current->next, &next, next | 1)) {
+            continue;
+        }
+
+        // Physical deletion. If it fails, a later traversal unlinks the node
+        uintptr_t expected = (uintptr_t) current;
+        if (atomic_compare_exchange_strong(previous, &expected, next)) {
+            lock_free_list_retire(list, thread, current);
+        } else {
+            lock_free_list_find(list, thread, value, &previous);
+        }
+
+        lock_free_list_exit(thread);
+        return 0;
+    }
+}
+
+/// Returns 1 if the set contains a specified value. This never writes to the list and never retries
+/// \param list The list to search in
+/// \param thread The handle of the calling thread
+/// \param value The value to search for
+/// \return 1 if the list contains that value, else 0
+int lock_free_list_contains(LockFreeList *list, LockFreeListThread *thread, int value) {
+    lock_free_list_enter(list, thread);
+
+    uintptr_t next = atomic_load(&list->head->next);
+    LockFreeListNode *current = (LockFreeListNode *) (next & ~(uintptr_t) 1);
+    while (current && current->value < value) {
+        current = (LockFreeListNode *) (atomic_load(&current->next) & ~(uintptr_t) 1);
+    }
+
+    int result = current && current->value == value && !(atomic_load(&current->next) & 1);
+
+    lock_free_list_exit(thread);
+    return result;
+}
+
+#endif
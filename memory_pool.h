@@ -0,0 +1,178 @@
+#ifndef MEMORY_POOL_H
+#define MEMORY_POOL_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+
+/*
+ * MEMORY POOL
+ *
+ * Hands out elements of one fixed size which are carved from larger blocks. Freed elements are kept in a free list and
+ * reused by the next allocation, so churn on a structure does not go through malloc and free for every node.
+ * Destroying the pool releases all blocks at once, so a structure living in a pool does not need to be walked to be
+ * destroyed.
+ */
+
+
+// DATA STRUCTURES
+
+typedef struct memory_pool_block MemoryPoolBlock;
+typedef struct memory_pool_element MemoryPoolElement;
+
+/// Elements are aligned like the most demanding of these types
+typedef union memory_pool_alignment {
+    void *pointer;
+    long long integer;
+    double floating_point;
+} MemoryPoolAlignment;
+
+/// A block is a header followed by the memory of its elements. All blocks of a pool are chained
+struct memory_pool_block {
+    MemoryPoolBlock *next;
+    MemoryPoolAlignment elements[];
+};
+
+/// A free element stores the link to the next free element in its own memory
+struct memory_pool_element {
+    MemoryPoolElement *next;
+};
+
+typedef struct memory_pool {
+    size_t element_size;
+    size_t elements_per_block;
+    MemoryPoolBlock *blocks;
+    MemoryPoolElement *free_elements;
+    char *unused;
+    size_t unused_count;
+} MemoryPool;
+
+// CONSTRUCTORS AND DESTRUCTORS
+
+/// Releases all blocks of the pool, which makes all elements ever allocated from it invalid. The pool itself stays
+/// usable
+/// \param pool The pool to clear
+void memory_pool_clear(MemoryPool *pool) {
+    MemoryPoolBlock *block = pool->blocks;
+    while (block) {
+        MemoryPoolBlock *next = block->next;
+        free(block);
+        block = next;
+    }
+
+    pool->blocks = NULL;
+    pool->free_elements = NULL;
+    pool->unused = NULL;
+    pool->unused_count = 0;
+}
+
+/// Destroys the pool and all of its blocks
+/// \param pool The pool to destroy
+/// \return A NULL pointer to be used for overwriting the object pointer
+MemoryPool *memory_pool_destroy(MemoryPool *pool) {
+    if (pool) {
+        memory_pool_clear(pool);
+    }
+    free(pool);
+    return NULL;
+}
+
+/// Creates a new pool. Blocks are only allocated once the first element is requested
+/// \param element_size The size of a single element, usually sizeof the node type
+/// \param elements_per_block The amount of elements which are allocated at once
+/// \return A pointer to the pool or NULL if memory allocation failed or one of the sizes was 0
+MemoryPool *memory_pool_create(size_t element_size, size_t elements_per_block) {
+    if (element_size == 0 || elements_per_block == 0) {
+        return NULL;
+    }
+
+    MemoryPool *result = calloc(1, sizeof(MemoryPool));
+    if (result == NULL) {
+        perror("Could not allocate memory!");
+        return NULL;
+    }
+
+    // Every element must be able to hold the free list link and keep the next element aligned
+    if (element_size < sizeof(MemoryPoolElement)) {
+        element_size = sizeof(MemoryPoolElement);
+    }
+    size_t alignment = sizeof(MemoryPoolAlignment);
+    result->element_size = (element_size + alignment - 1) / alignment * alignment;
+    result->elements_per_block = elements_per_block;
+
+    return result;
+}
+
+// FUNCTIONS
+
+/// Fetches an element from the pool, preferring previously freed elements over fresh ones
+/// \param pool The pool to allocate from
+/// \return A pointer to uninitialized memory of the pool's element size or NULL if memory allocation failed
+void *memory_pool_allocate(MemoryPool *pool) {
+
+    // Reuse a freed element
+    if (pool->free_elements) {
+        MemoryPoolElement *result = pool->free_elements;
+        pool->free_elements = result->next;
+        return result;
+    }
+
+    // Get a new block if the current one is used up
+    if (pool->unused_count == 0) {
+        MemoryPoolBlock *block = malloc(sizeof(MemoryPoolBlock) + pool->element_size * pool->elements_per_block);
+        if (block == NULL) {
+            perror("Could not allocate memory!");
+            return NULL;
+        }
+
+        block->next = pool->blocks;
+        pool->blocks = block;
+        pool->unused = (char *) block->elements;
+        pool->unused_count = pool->elements_per_block;
+    }
+
+    void *result = pool->unused;
+    pool->unused += pool->element_size;
+    --pool->unused_count;
+    return result;
+}
+
+/// Fetches count consecutive elements from a block of their own, so a structure of known size can be laid out in one
+/// piece. The elements may be freed one by one like any other element of the pool
+/// \param pool The pool to allocate from
+/// \param count The amount of elements, which are pool->element_size bytes apart
+/// \return A pointer to the first element or NULL if memory allocation failed or count was 0
+void *memory_pool_allocate_array(MemoryPool *pool, size_t count) {
+    if (count == 0 || count > (SIZE_MAX - sizeof(MemoryPoolBlock)) / pool->element_size) {
+        return NULL;
+    }
+
+    MemoryPoolBlock *block = malloc(sizeof(MemoryPoolBlock) + pool->element_size * count);
+    if (block == NULL) {
+        perror("Could not allocate memory!");
+        return NULL;
+    }
+
+    // Chain the block behind the current one, which keeps handing out its unused elements
+    if (pool->blocks) {
+        block->next = pool->blocks->next;
+        pool->blocks->next = block;
+    } else {
+        block->next = NULL;
+        pool->blocks = block;
+    }
+    return block->elements;
+}
+
+/// Gives an element back to the pool so it can be reused
+/// \param pool The pool the element was allocated from
+/// \param element The element to free. May be NULL
+void memory_pool_free(MemoryPool *pool, void *element) {
+    if (element) {
+        MemoryPoolElement *freed = element;
+        freed->next = pool->free_elements;
+        pool->free_elements = freed;
+    }
+}
+
+#endif
@@ -0,0 +1,418 @@
+#ifndef PERSISTENT_TREE_H
+#define PERSISTENT_TREE_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdatomic.h>
+
+/*
+ * PERSISTENT TREE
+ *
+ * A balanced binary search tree of ints whose nodes never change once they are reachable. An update copies the path
+ * from the root down to the changed node and shares all other subtrees with the previous version, so every update
+ * creates a new version in O(log n) time and space while older versions stay intact. Rebalancing uses AVL rotations
+ * on the copied path, which keeps the copies short for any insertion order. Like the Binary Tree it holds duplicates.
+ * There are no parent pointers, since a shared node has a parent in every version containing it.
+ *
+ * Readers acquire the current version as a snapshot and may scan it for as long as they like without any locking,
+ * while the writer keeps publishing new versions. Every pointer to a node, from a parent, a tree or a snapshot, holds
+ * a reference, and a node is freed when the last one is dropped, so a version dies together with its last snapshot.
+ *
+ * Publishing and acquiring a version share a spin lock which is only held for swapping or copying the root pointer.
+ * Updates must not run concurrently with each other. Uses C11 atomics.
+ */
+
+
+/// An AVL tree of 2^64 nodes is lower than this, so it bounds the stack of an in-order scan
+#define PERSISTENT_TREE_MAX_HEIGHT 96
+
+// DATA STRUCTURES
+
+typedef struct persistent_tree_node PersistentTreeNode;
+
+/// All fields but references are constant once the node is reachable
+struct persistent_tree_node {
+    int value;
+    int height;
+    size_t size;
+    _Atomic size_t references;
+    PersistentTreeNode *left;
+    PersistentTreeNode *right;
+};
+
+/// root is the current version, the tree holds one reference to it
+typedef struct persistent_tree {
+    PersistentTreeNode *root;
+    atomic_flag lock;
+} PersistentTree;
+
+/// Called by range scans for every value, a return value other than 0 stops the scan
+typedef int (*persistent_tree_visitor)(int value, void *context);
+
+// CONSTRUCTORS AND DESTRUCTORS
+
+/// Adds a reference to a node
+/// \param node The node, which may be NULL
+/// \return The node
+PersistentTreeNode *persistent_tree_retain(PersistentTreeNode *node) {
+    if (node) {
+        atomic_fetch_add_explicit(&node->references, 1, memory_order_relaxed);
+    }
+    return node;
+}
+
+/// Drops a reference to a node and frees every node which is no longer referenced. Unreferenced left children are
+/// rotated up and the chain of right children is freed while walking down it, so no recursion or stack is needed
+/// \param node The node, which may be NULL
+/// \return A NULL pointer to clean up the node pointer
+PersistentTreeNode *persistent_tree_release(PersistentTreeNode *node) {
+    if (node == NULL || atomic_fetch_sub_explicit(&node->references, 1, memory_order_acq_rel) != 1) {
+        return NULL;
+    }
+
+    while (node) {
+        PersistentTreeNode *left = node->left;
+        if (left && atomic_fetch_sub_explicit(&left->references, 1, memory_order_acq_rel) == 1) {
+            // The rotation moves the reference of left to its right child over to node, and the new pointer from left
+            // to node needs a reference of its own
+            node->left = left->right;
+            atomic_store_explicit(&node->references, 1, memory_order_relaxed);
+            left->right = node;
+            node = left;
+        } else if (left) {
+            node->left = NULL;
+        } else {
+            PersistentTreeNode *right = node->right;
+            free(node);
+            int dead = right && atomic_fetch_sub_explicit(&right->references, 1, memory_order_acq_rel) == 1;
+            node = dead ? right : NULL;
+        }
+    }
+    return NULL;
+}
+
+int persistent_tree_height(const PersistentTreeNode *node) {
+    return node ? node->height : 0;
+}
+
+/// Returns the amount of values in a version
+/// \param root The root of the version, which may be NULL
+/// \return The size, 0 for an empty version
+size_t persistent_tree_size(const PersistentTreeNode *root) {
+    return root ? root->size : 0;
+}
+
+/// Creates a node, taking over the references to its children
+/// \param value The value of the new node
+/// \param left The left child
+/// \param right The right child
+/// \param error Set to 1 in case of memory error, in which case the children are released
+/// \return The new node with one reference or NULL in case of memory error
+PersistentTreeNode *persistent_tree_node_create(int value, PersistentTreeNode *left, PersistentTreeNode *right,
+                                                int *error) {
+    PersistentTreeNode *result = malloc(sizeof(PersistentTreeNode));
+    if (result == NULL) {
+        perror("Could not allocate memory!");
+        persistent_tree_release(left);
+        persistent_tree_release(right);
+        *error = 1;
+        return NULL;
+    }
+
+    int left_height = persistent_tree_height(left);
+    int right_height = persistent_tree_height(right);
+
+    result->value = value;
+    result->height = (left_height > right_height ? left_height : right_height) + 1;
+    result->size = persistent_tree_size(left) + persistent_tree_size(right) + 1;
+    atomic_init(&result->references, (size_t) 1);
+    result->left = left;
+    result->right = right;
+    return result;
+}
+
+/// Creates an empty persistent tree
+/// \return A pointer to the tree or NULL in case of memory error
+PersistentTree *persistent_tree_create() {
+    PersistentTree *result = malloc(sizeof(PersistentTree));
+    if (result == NULL) {
+        perror("Could not allocate memory!");
+        return NULL;
+    }
+
+    result->root = NULL;
+    atomic_flag_clear(&result->lock);
+    return result;
+}
+
+/// Destroys the tree. Snapshots acquired from it stay valid until they are released
+/// \param tree The tree to destroy
+/// \return A NULL pointer to clean up the tree pointer
+PersistentTree *persistent_tree_destroy(PersistentTree *tree) {
+    if (tree) {
+        tree->root = persistent_tree_release(tree->root);
+    }
+    free(tree);
+    return NULL;
+}
+
+// FUNCTIONS
+
+/// Acquires the current version of the tree. It never changes and stays valid until it is released
+/// \param tree The tree
+/// \return The root of the version, NULL for an empty tree
+PersistentTreeNode *persistent_tree_acquire(PersistentTree *tree) {
+    while (atomic_flag_test_and_set_explicit(&tree->lock, memory_order_acquire)) {
+    }
+    PersistentTreeNode *result = persistent_tree_retain(tree->root);
+    atomic_flag_clear_explicit(&tree->lock, memory_order_release);
+    return result;
+}
+
+/// Makes a new version the current one and drops the tree's reference to the previous version
+/// \param tree The tree
+/// \param root The root of the new version, whose reference is taken over
+void persistent_tree_publish(PersistentTree *tree, PersistentTreeNode *root) {
+    while (atomic_flag_test_and_set_explicit(&tree->lock, memory_order_acquire)) {
+    }
+    PersistentTreeNode *previous = tree->root;
+    tree->root = root;
+    atomic_flag_clear_explicit(&tree->lock, memory_order_release);
+
+    persistent_tree_release(previous);
+}
+
+/// Creates a node from a value and two subtrees whose heights differ by at most two, rotating if they differ by two.
+/// Takes over the references to both subtrees. Nodes replaced by a rotation only lose the reference given to this
+/// function, so versions sharing them are not affected
+/// \param value The value of the new node
+/// \param left The left subtree
+/// \param right The right subtree
+/// \param error Set to 1 in case of memory error, in which case both subtrees are released
+/// \return The root of the balanced subtree with one reference or NULL in case of memory error
+PersistentTreeNode *persistent_tree_balance(int value, PersistentTreeNode *left, PersistentTreeNode *right,
+                                            int *error) {
+    int balance = persistent_tree_height(left) - persistent_tree_height(right);
+
+    if (balance > 1) {
+        PersistentTreeNode *result;
+        if (persistent_tree_height(left->left) >= persistent_tree_height(left->right)) {
+            PersistentTreeNode *lower = persistent_tree_node_create(value, persistent_tree_retain(left->right), right,
+                                                                    error);
+            result = lower ? persistent_tree_node_create(left->value, persistent_tree_retain(left->left), lower, error)
+                           : NULL;
+        } else {
+            PersistentTreeNode *pivot = left->right;
+            PersistentTreeNode *lower_left = persistent_tree_node_create(left->value,
+                                                                         persistent_tree_retain(left->left),
+                                                                         persistent_tree_retain(pivot->left), error);
+            PersistentTreeNode *lower_right = persistent_tree_node_create(value, persistent_tree_retain(pivot->right),
+                                                                          right, error);
+            if (*error) {
+                persistent_tree_release(lower_left);
+                persistent_tree_release(lower_right);
+                result = NULL;
+            } else {
+                result = persistent_tree_node_create(pivot->value, lower_left, lower_right, error);
+            }
+        }
+        persistent_tree_release(left);
+        return result;
+    }
+
+    if (balance < -1) {
+        PersistentTreeNode *result;
+        if (persistent_tree_height(right->right) >= persistent_tree_height(right->left)) {
+            PersistentTreeNode *lower = persistent_tree_node_create(value, left, persistent_tree_retain(right->left),
+                                                                    error);
+            result = lower ? persistent_tree_node_create(right->value, lower, persistent_tree_retain(right->right),
+                                                         error)
+                           : NULL;
+        } else {
+            PersistentTreeNode *pivot = right->left;
+            PersistentTreeNode *lower_left = persistent_tree_node_create(value, left,
+                                                                         persistent_tree_retain(pivot->left), error);
+            PersistentTreeNode *lower_right = persistent_tree_node_create(right->value,
+                                                                          persistent_tree_retain(pivot->right),
+                                                                          persistent_tree_retain(right->right), error);
+            if (*error) {
+                persistent_tree_release(lower_left);
+                persistent_tree_release(lower_right);
+                result = NULL;
+            } else {
+                result = persistent_tree_node_create(pivot->value, lower_left, lower_right, error);
+            }
+        }
+        persistent_tree_release(right);
+        return result;
+    }
+
+    return persistent_tree_node_create(value, left, right, error);
+}
+
+/// Inserts a value into a version by copying the path to its position
+/// \param node The subtree, which keeps all of its references
+/// \param value The value to insert
+/// \param error Set to 1 in case of memory error
+/// \return The root of the new subtree with one reference or NULL in case of memory error
+PersistentTreeNode *persistent_tree_insert(PersistentTreeNode *node, int value, int *error) {
+    if (node == NULL) {
+        return persistent_tree_node_create(value, NULL, NULL, error);
+    }
+
+    if (node->value >= value) {
+        PersistentTreeNode *left = persistent_tree_insert(node->left, value, error);
+        if (*error) {
+            return NULL;
+        }
+        return persistent_tree_balance(node->value, left, persistent_tree_retain(node->right), error);
+    }
+
+    PersistentTreeNode *right = persistent_tree_insert(node->right, value, error);
+    if (*error) {
+        return NULL;
+    }
+    return persistent_tree_balance(node->value, persistent_tree_retain(node->left), right, error);
+}
+
+/// Removes the smallest value from a version by copying the path to it
+/// \param node The non-empty subtree, which keeps all of its references
+/// \param minimum Receives the removed value
+/// \param error Set to 1 in case of memory error
+/// \return The root of the new subtree with one reference, NULL if it is empty or in case of memory error
+PersistentTreeNode *persistent_tree_remove_minimum(PersistentTreeNode *node, int *minimum, int *error) {
+    if (node->left == NULL) {
+        *minimum = node->value;
+        return persistent_tree_retain(node->right);
+    }
+
+    PersistentTreeNode *left = persistent_tree_remove_minimum(node->left, minimum, error);
+    if (*error) {
+        return NULL;
+    }
+    return persistent_tree_balance(node->value, left, persistent_tree_retain(node->right), error);
+}
+
+/// Removes one occurrence of a value from a version by copying the path to it. The value has to be contained
+/// \param node The subtree, which keeps all of its references
+/// \param value The value to remove
+/// \param error Set to 1 in case of memory error
+/// \return The root of the new subtree with one reference, NULL if it is empty or in case of memory error
+PersistentTreeNode *persistent_tree_remove(PersistentTreeNode *node, int value, int *error) {
+    if (value < node->value) {
+        PersistentTreeNode *left = persistent_tree_remove(node->left, value, error);
+        if (*error) {
+            return NULL;
+        }
+        return persistent_tree_balance(node->value, left, persistent_tree_retain(node->right), error);
+    }
+    if (value > node->value) {
+        PersistentTreeNode *right = persistent_tree_remove(node->right, value, error);
+        if (*error) {
+            return NULL;
+        }
+        return persistent_tree_balance(node->value, persistent_tree_retain(node->left), right, error);
+    }
+
+    if (node->left == NULL || node->right == NULL) {
+        return persistent_tree_retain(node->left ? node->left : node->right);
+    }
+
+    // Replace the value by its in-order successor
+    int successor;
+    PersistentTreeNode *right = persistent_tree_remove_minimum(node->right, &successor, error);
+    if (*error) {
+        return NULL;
+    }
+    return persistent_tree_balance(successor, persistent_tree_retain(node->left), right, error);
+}
+
+/// Checks whether a version holds a value
+/// \param root The root of the version
+/// \param value The value to search
+/// \return 1 if the value was found, else 0
+int persistent_tree_contains(const PersistentTreeNode *root, int value) {
+    while (root && root->value != value) {
+        root = (value < root->value) ? root->left : root->right;
+    }
+    return root != NULL;
+}
+
+/// Adds a value to the tree and publishes the new version
+/// \param tree The tree to extend
+/// \param value The value to insert
+/// \return 0 if successful, else 1 in case of memory error
+int persistent_tree_add(PersistentTree *tree, int value) {
+    int error = 0;
+    PersistentTreeNode *root = persistent_tree_insert(tree->root, value, &error);
+    if (error) {
+        return 1;
+    }
+
+    persistent_tree_publish(tree, root);
+    return 0;
+}
+
+/// Removes one occurrence of a value from the tree and publishes the new version
+/// \param tree The tree to remove from
+/// \param value The value to remove
+/// \return 0 if the value was removed, 1 in case of memory error and 2 if the tree doesn't contain the value
+int persistent_tree_delete(PersistentTree *tree, int value) {
+    if (!persistent_tree_contains(tree->root, value)) {
+        return 2;
+    }
+
+    int error = 0;
+    PersistentTreeNode *root = persistent_tree_remove(tree->root, value, &error);
+    if (error) {
+        return 1;
+    }
+
+    persistent_tree_publish(tree, root);
+    return 0;
+}
+
+/// Visits all values of a version between lo and hi in ascending order
+/// \param root The root of the version
+/// \param lo The lower bound, included
+/// \param hi The upper bound, included
+/// \param visitor The function to call for every value
+/// \param context Passed to every call of visitor
+/// \return The amount of visited values
+size_t persistent_tree_range_scan(const PersistentTreeNode *root, int lo, int hi, persistent_tree_visitor visitor,
+                                  void *context) {
+    const PersistentTreeNode *stack[PERSISTENT_TREE_MAX_HEIGHT];
+    size_t depth = 0;
+    size_t count = 0;
+
+    // The stack holds the ancestors whose value is still to be visited, so subtrees left of lo are never entered
+    const PersistentTreeNode *node = root;
+    while (node) {
+        if (node->value < lo) {
+            node = node->right;
+        } else {
+            stack[depth++] = node;
+            node = node->left;
+        }
+    }
+
+    while (depth) {
+        node = stack[--depth];
+        if (node->value > hi) {
+            break;
+        }
+
+        ++count;
+        if (visitor(node->value, context)) {
+            break;
+        }
+
+        for (node = node->right; node; node = node->left) {
+            stack[depth++] = node;
+        }
+    }
+    return count;
+}
+
+#endif
@@ -0,0 +1,520 @@
+#ifndef SIMD_H
+#define SIMD_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdatomic.h>
+
+/*
+ * Contains vectorized kernels for int arrays:
+ *
+ * - Find first
+ * - Count equal
+ * - Minimum / maximum with index
+ * - Sum
+ * - Sortedness check
+ * - Max-heap check
+ *
+ * Every kernel has a scalar, an SSE2 and an AVX2 version. The plain simd_* functions pick the best version the CPU
+ * supports at runtime, so programs don't need to be compiled with -mavx2. On compilers or architectures without x86
+ * intrinsics only the scalar versions are used.
+ */
+
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define SIMD_X86 1
+#include <immintrin.h>
+#define SIMD_TARGET_SSE2 __attribute__((target("sse2")))
+#define SIMD_TARGET_AVX2 __attribute__((target("avx2")))
+
+/// The amount of vectors the count kernels process before their 32 bit lane counters could overflow
+#define SIMD_COUNT_BLOCK ((size_t) 1 << 30)
+#else
+#define SIMD_X86 0
+#endif
+
+typedef enum {SIMD_LEVEL_UNKNOWN, SIMD_LEVEL_SCALAR, SIMD_LEVEL_SSE2, SIMD_LEVEL_AVX2} SimdLevel;
+
+/// The level used by the dispatching functions, detected on first use. Atomic because threads may make their first
+/// dispatching call at the same time. Relaxed accesses suffice, since the level guards no other data
+_Atomic SimdLevel simd_active_level = SIMD_LEVEL_UNKNOWN;
+
+/// Detects the best instruction set the CPU supports
+/// \return The detected level
+SimdLevel simd_detect_level() {
+#if SIMD_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        return SIMD_LEVEL_AVX2;
+    }
+    if (__builtin_cpu_supports("sse2")) {
+        return SIMD_LEVEL_SSE2;
+    }
+#endif
+    return SIMD_LEVEL_SCALAR;
+}
+
+/// Returns the level used by the dispatching functions
+/// \return The active level
+SimdLevel simd_level() {
+    SimdLevel level = atomic_load_explicit(&simd_active_level, memory_order_relaxed);
+    if (level == SIMD_LEVEL_UNKNOWN) {
+        level = simd_detect_level();
+        atomic_store_explicit(&simd_active_level, level, memory_order_relaxed);
+    }
+    return level;
+}
+
+/// Restricts the dispatching functions to a level, e.g. for benchmarks. Levels the CPU lacks are lowered to the best
+/// supported one
+/// \param level The level to use
+/// \return The level which is actually used
+SimdLevel simd_set_level(SimdLevel level) {
+    SimdLevel detected = simd_detect_level();
+    level = level > detected || level == SIMD_LEVEL_UNKNOWN ? detected : level;
+    atomic_store_explicit(&simd_active_level, level, memory_order_relaxed);
+    return level;
+}
+
+
+/* ### SCALAR ### */
+
+
+/// Returns the index of the first occurrence of value or size if the array doesn't contain it
+size_t simd_find_first_scalar(const int *array, size_t size, int value) {
+    for (size_t i = 0; i < size; ++i) {
+        if (array[i] == value) {
+            return i;
+        }
+    }
+    return size;
+}
+
+/// Returns the amount of elements equal to value
+size_t simd_count_equal_scalar(const int *array, size_t size, int value) {
+    size_t count = 0;
+    for (size_t i = 0; i < size; ++i) {
+        count += array[i] == value;
+    }
+    return count;
+}
+
+/// Returns the index of the first minimum or size if the array is empty
+size_t simd_min_index_scalar(const int *array, size_t size) {
+    size_t result = size;
+    for (size_t i = 0; i < size; ++i) {
+        if (result == size || array[i] < array[result]) {
+            result = i;
+        }
+    }
+    return result;
+}
+
+/// Returns the index of the first maximum or size if the array is empty
+size_t simd_max_index_scalar(const int *array, size_t size) {
+    size_t result = size;
+    for (size_t i = 0; i < size; ++i) {
+        if (result == size || array[i] > array[result]) {
+            result = i;
+        }
+    }
+    return result;
+}
+
+/// Returns the sum of all elements, which can not overflow for less than 2^32 elements
+int64_t simd_sum_scalar(const int *array, size_t size) {
+    int64_t sum = 0;
+    for (size_t i = 0; i < size; ++i) {
+        sum += array[i];
+    }
+    return sum;
+}
+
+/// Returns 1 if the array is sorted in ascending order, else 0
+int simd_is_sorted_scalar(const int *array, size_t size) {
+    for (size_t i = 1; i < size; ++i) {
+        if (array[i - 1] > array[i]) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/// Returns 1 if no element of the array is larger than its parent at (index - 1) / 2, else 0
+int simd_is_max_heap_scalar(const int *array, size_t size) {
+    for (size_t i = 1; i < size; ++i) {
+        if (array[i] > array[(i - 1) / 2]) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+
+#if SIMD_X86
+
+/* ### SSE2 ###
+ *
+ * SSE2 lacks 32 bit minimum and maximum as well as sign extension, so these are built from compares and unpacks
+ */
+
+
+SIMD_TARGET_SSE2 size_t simd_find_first_sse2(const int *array, size_t size, int value) {
+    const __m128i needle = _mm_set1_epi32(value);
+    size_t i = 0;
+
+    for (; i + 4 <= size; i += 4) {
+        __m128i equal = _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i *) (array + i)), needle);
+        int mask = _mm_movemask_epi8(equal);
+        if (mask) {
+            return i + (size_t) __builtin_ctz((unsigned) mask) / 4;
+        }
+    }
+
+    size_t rest = simd_find_first_scalar(array + i, size - i, value);
+    return i + rest;
+}
+
+SIMD_TARGET_SSE2 size_t simd_count_equal_sse2(const int *array, size_t size, int value) {
+    const __m128i needle = _mm_set1_epi32(value);
+    size_t count = 0;
+    size_t i = 0;
+
+    while (i + 4 <= size) {
+
+        // Matches are -1, so subtracting them counts per lane. Every lane grows by at most one per vector, so the
+        // lanes are summed up before SIMD_COUNT_BLOCK vectors could overflow them
+        __m128i counts = _mm_setzero_si128();
+        size_t end = size - i > SIMD_COUNT_BLOCK * 4 ? i + SIMD_COUNT_BLOCK * 4 : size;
+        for (; i + 4 <= end; i += 4) {
+            counts = _mm_sub_epi32(counts, _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i *) (array + i)), needle));
+        }
+
+        uint32_t lanes[4];
+        _mm_storeu_si128((__m128i *) lanes, counts);
+        count += (size_t) lanes[0] + lanes[1] + lanes[2] + lanes[3];
+    }
+
+    return count + simd_count_equal_scalar(array + i, size - i, value);
+}
+
+/// Reduces four lanes to the smallest (maximum = 0) or largest (maximum = 1) of them
+SIMD_TARGET_SSE2 int simd_reduce_sse2(__m128i values, int maximum) {
+    int lanes[4];
+    _mm_storeu_si128((__m128i *) lanes, values);
+
+    int result = lanes[0];
+    for (size_t i = 1; i < 4; ++i) {
+        if (maximum ? lanes[i] > result : lanes[i] < result) {
+            result = lanes[i];
+        }
+    }
+    return result;
+}
+
+/// Finds the extreme value in one vectorized pass and then its first index in a second one
+SIMD_TARGET_SSE2 size_t simd_extreme_index_sse2(const int *array, size_t size, int maximum) {
+    if (size < 4) {
+        return maximum ? simd_max_index_scalar(array, size) : simd_min_index_scalar(array, size);
+    }
+
+    __m128i extreme = _mm_loadu_si128((const __m128i *) array);
+    size_t i = 4;
+    for (; i + 4 <= size; i += 4) {
+        __m128i values = _mm_loadu_si128((const __m128i *) (array + i));
+        __m128i take = maximum ? _mm_cmpgt_epi32(values, extreme) : _mm_cmplt_epi32(values, extreme);
+        extreme = _mm_or_si128(_mm_and_si128(take, values), _mm_andnot_si128(take, extreme));
+    }
+
+    int result = simd_reduce_sse2(extreme, maximum);
+    for (; i < size; ++i) {
+        if (maximum ? array[i] > result : array[i] < result) {
+            result = array[i];
+        }
+    }
+
+    return simd_find_first_sse2(array, size, result);
+}
+
+SIMD_TARGET_SSE2 size_t simd_min_index_sse2(const int *array, size_t size) {
+    return simd_extreme_index_sse2(array, size, 0);
+}
+
+SIMD_TARGET_SSE2 size_t simd_max_index_sse2(const int *array, size_t size) {
+    return simd_extreme_index_sse2(array, size, 1);
+}
+
+SIMD_TARGET_SSE2 int64_t simd_sum_sse2(const int *array, size_t size) {
+    const __m128i zero = _mm_setzero_si128();
+    __m128i sums = zero;
+    size_t i = 0;
+
+    for (; i + 4 <= size; i += 4) {
+        __m128i values = _mm_loadu_si128((const __m128i *) (array + i));
+
+        // Sign extend to 64 bit by interleaving with the sign mask
+        __m128i sign = _mm_cmpgt_epi32(zero, values);
+        sums = _mm_add_epi64(sums, _mm_unpacklo_epi32(values, sign));
+        sums = _mm_add_epi64(sums, _mm_unpackhi_epi32(values, sign));
+    }
+
+    int64_t lanes[2];
+    _mm_storeu_si128((__m128i *) lanes, sums);
+    return lanes[0] + lanes[1] + simd_sum_scalar(array + i, size - i);
+}
+
+SIMD_TARGET_SSE2 int simd_is_sorted_sse2(const int *array, size_t size) {
+    size_t i = 0;
+
+    // Compare every element with its successor, four at a time
+    for (; i + 4 < size; i += 4) {
+        __m128i current = _mm_loadu_si128((const __m128i *) (array + i));
+        __m128i next = _mm_loadu_si128((const __m128i *) (array + i + 1));
+        if (_mm_movemask_epi8(_mm_cmpgt_epi32(current, next))) {
+            return 0;
+        }
+    }
+
+    return simd_is_sorted_scalar(array + i, size - i);
+}
+
+SIMD_TARGET_SSE2 int simd_is_max_heap_sse2(const int *array, size_t size) {
+    size_t parent = 0;
+
+    // The children of the parents p..p+3 are the eight consecutive elements starting at 2p+1, so duplicating every
+    // parent lines them up with their children
+    for (; 2 * parent + 9 <= size; parent += 4) {
+        __m128i parents = _mm_loadu_si128((const __m128i *) (array + parent));
+        __m128i low = _mm_loadu_si128((const __m128i *) (array + 2 * parent + 1));
+        __m128i high = _mm_loadu_si128((const __m128i *) (array + 2 * parent + 5));
+        __m128i violations = _mm_or_si128(_mm_cmpgt_epi32(low, _mm_unpacklo_epi32(parents, parents)),
+                                          _mm_cmpgt_epi32(high, _mm_unpackhi_epi32(parents, parents)));
+        if (_mm_movemask_epi8(violations)) {
+            return 0;
+        }
+    }
+
+    for (size_t i = 2 * parent + 1; i < size; ++i) {
+        if (array[i] > array[(i - 1) / 2]) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+
+/* ### AVX2 ### */
+
+
+SIMD_TARGET_AVX2 size_t simd_find_first_avx2(const int *array, size_t size, int value) {
+    const __m256i needle = _mm256_set1_epi32(value);
+    size_t i = 0;
+
+    for (; i + 8 <= size; i += 8) {
+        __m256i equal = _mm256_cmpeq_epi32(_mm256_loadu_si256((const __m256i *) (array + i)), needle);
+        unsigned mask = (unsigned) _mm256_movemask_epi8(equal);
+        if (mask) {
+            return i + (size_t) __builtin_ctz(mask) / 4;
+        }
+    }
+
+    size_t rest = simd_find_first_scalar(array + i, size - i, value);
+    return i + rest;
+}
+
+SIMD_TARGET_AVX2 size_t simd_count_equal_avx2(const int *array, size_t size, int value) {
+    const __m256i needle = _mm256_set1_epi32(value);
+    size_t count = 0;
+    size_t i = 0;
+
+    while (i + 8 <= size) {
+        __m256i counts = _mm256_setzero_si256();
+        size_t end = size - i > SIMD_COUNT_BLOCK * 8 ? i + SIMD_COUNT_BLOCK * 8 : size;
+        for (; i + 8 <= end; i += 8) {
+            __m256i values = _mm256_loadu_si256((const __m256i *) (array + i));
+            counts = _mm256_sub_epi32(counts, _mm256_cmpeq_epi32(values, needle));
+        }
+
+        uint32_t lanes[8];
+        _mm256_storeu_si256((__m256i *) lanes, counts);
+        for (size_t lane = 0; lane < 8; ++lane) {
+            count += lanes[lane];
+        }
+    }
+
+    return count + simd_count_equal_scalar(array + i, size - i, value);
+}
+
+/// Finds the extreme value in one vectorized pass and then its first index in a second one
+SIMD_TARGET_AVX2 size_t simd_extreme_index_avx2(const int *array, size_t size, int maximum) {
+    if (size < 8) {
+        return maximum ? simd_max_index_scalar(array, size) : simd_min_index_scalar(array, size);
+    }
+
+    __m256i extreme = _mm256_loadu_si256((const __m256i *) array);
+    size_t i = 8;
+    for (; i + 8 <= size; i += 8) {
+        __m256i values = _mm256_loadu_si256((const __m256i *) (array + i));
+        extreme = maximum ? _mm256_max_epi32(extreme, values) : _mm256_min_epi32(extreme, values);
+    }
+
+    // Fold the eight lanes down to one
+    __m128i folded = maximum
+            ? _mm_max_epi32(_mm256_castsi256_si128(extreme), _mm256_extracti128_si256(extreme, 1))
+            : _mm_min_epi32(_mm256_castsi256_si128(extreme), _mm256_extracti128_si256(extreme, 1));
+    __m128i swapped = _mm_shuffle_epi32(folded, _MM_SHUFFLE(1, 0, 3, 2));
+    folded = maximum ? _mm_max_epi32(folded, swapped) : _mm_min_epi32(folded, swapped);
+    swapped = _mm_shuffle_epi32(folded, _MM_SHUFFLE(2, 3, 0, 1));
+    folded = maximum ? _mm_max_epi32(folded, swapped) : _mm_min_epi32(folded, swapped);
+
+    int result = _mm_cvtsi128_si32(folded);
+    for (; i < size; ++i) {
+        if (maximum ? array[i] > result : array[i] < result) {
+            result = array[i];
+        }
+    }
+
+    return simd_find_first_avx2(array, size, result);
+}
+
+SIMD_TARGET_AVX2 size_t simd_min_index_avx2(const int *array, size_t size) {
+    return simd_extreme_index_avx2(array, size, 0);
+}
+
+SIMD_TARGET_AVX2 size_t simd_max_index_avx2(const int *array, size_t size) {
+    return simd_extreme_index_avx2(array, size, 1);
+}
+
+SIMD_TARGET_AVX2 int64_t simd_sum_avx2(const int *array, size_t size) {
+    __m256i sums = _mm256_setzero_si256();
+    size_t i = 0;
+
+    for (; i + 8 <= size; i += 8) {
+        __m256i values = _mm256_loadu_si256((const __m256i *) (array + i));
+        sums = _mm256_add_epi64(sums, _mm256_cvtepi32_epi64(_mm256_castsi256_si128(values)));
+        sums = _mm256_add_epi64(sums, _mm256_cvtepi32_epi64(_mm256_extracti128_si256(values, 1)));
+    }
+
+    int64_t lanes[4];
+    _mm256_storeu_si256((__m256i *) lanes, sums);
+    return lanes[0] + lanes[1] + lanes[2] + lanes[3] + simd_sum_scalar(array + i, size - i);
+}
+
+SIMD_TARGET_AVX2 int simd_is_sorted_avx2(const int *array, size_t size) {
+    size_t i = 0;
+
+    for (; i + 8 < size; i += 8) {
+        __m256i current = _mm256_loadu_si256((const __m256i *) (array + i));
+        __m256i next = _mm256_loadu_si256((const __m256i *) (array + i + 1));
+        if (_mm256_movemask_epi8(_mm256_cmpgt_epi32(current, next))) {
+            return 0;
+        }
+    }
+
+    return simd_is_sorted_scalar(array + i, size - i);
+}
+
+SIMD_TARGET_AVX2 int simd_is_max_heap_avx2(const int *array, size_t size) {
+    const __m256i low_parents = _mm256_setr_epi32(0, 0, 1, 1, 2, 2, 3, 3);
+    const __m256i high_parents = _mm256_setr_epi32(4, 4, 5, 5, 6, 6, 7, 7);
+    size_t parent = 0;
+
+    for (; 2 * parent + 17 <= size; parent += 8) {
+        __m256i parents = _mm256_loadu_si256((const __m256i *) (array + parent));
+        __m256i low = _mm256_loadu_si256((const __m256i *) (array + 2 * parent + 1));
+        __m256i high = _mm256_loadu_si256((const __m256i *) (array + 2 * parent + 9));
+        __m256i violations = _mm256_or_si256(
+                _mm256_cmpgt_epi32(low, _mm256_permutevar8x32_epi32(parents, low_parents)),
+                _mm256_cmpgt_epi32(high, _mm256_permutevar8x32_epi32(parents, high_parents)));
+        if (_mm256_movemask_epi8(violations)) {
+            return 0;
+        }
+    }
+
+    for (size_t i = 2 * parent + 1; i < size; ++i) {
+        if (array[i] > array[(i - 1) / 2]) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+#endif
+
+
+/* ### DISPATCH ### */
+
+
+#if SIMD_X86
+#define SIMD_DISPATCH(kernel, ...) \
+    switch (simd_level()) { \
+        case SIMD_LEVEL_AVX2: \
+            return kernel##_avx2(__VA_ARGS__); \
+        case SIMD_LEVEL_SSE2: \
+            return kernel##_sse2(__VA_ARGS__); \
+        default: \
+            return kernel##_scalar(__VA_ARGS__); \
+    }
+#else
+#define SIMD_DISPATCH(kernel, ...) return kernel##_scalar(__VA_ARGS__);
+#endif
+
+/// Searches for the first occurrence of a value
+/// \param array The array to search in
+/// \param size The amount of elements
+/// \param value The value to search for
+/// \return The index of the first occurrence or size if the array doesn't contain the value
+size_t simd_find_first(const int *array, size_t size, int value) {
+    SIMD_DISPATCH(simd_find_first, array, size, value)
+}
+
+/// Counts the occurrences of a value
+/// \param array The array to search in
+/// \param size The amount of elements
+/// \param value The value to count
+/// \return The amount of elements equal to value
+size_t simd_count_equal(const int *array, size_t size, int value) {
+    SIMD_DISPATCH(simd_count_equal, array, size, value)
+}
+
+/// Finds the smallest element
+/// \param array The array to search in
+/// \param size The amount of elements
+/// \return The index of the first minimum or size if the array is empty
+size_t simd_min_index(const int *array, size_t size) {
+    SIMD_DISPATCH(simd_min_index, array, size)
+}
+
+/// Finds the largest element
+/// \param array The array to search in
+/// \param size The amount of elements
+/// \return The index of the first maximum or size if the array is empty
+size_t simd_max_index(const int *array, size_t size) {
+    SIMD_DISPATCH(simd_max_index, array, size)
+}
+
+/// Sums up all elements in 64 bit
+/// \param array The array to sum up
+/// \param size The amount of elements
+/// \return The sum
+int64_t simd_sum(const int *array, size_t size) {
+    SIMD_DISPATCH(simd_sum, array, size)
+}
+
+/// Checks if an array is sorted in ascending order
+/// \param array The array to check
+/// \param size The amount of elements
+/// \return 1 if the array is sorted, else 0
+int simd_is_sorted(const int *array, size_t size) {
+    SIMD_DISPATCH(simd_is_sorted, array, size)
+}
+
+/// Checks if an array satisfies the max-heap property, i.e. no element is larger than its parent
+/// \param array The array to check
+/// \param size The amount of elements
+/// \return 1 if the array is a max-heap, else 0
+int simd_is_max_heap(const int *array, size_t size) {
+    SIMD_DISPATCH(simd_is_max_heap, array, size)
+}
+
+#endif
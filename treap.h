@@ -0,0 +1,438 @@
+#ifndef TREAP_H
+#define TREAP_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <pthread.h>
+
+/*
+ * TREAP
+ *
+ * A set of ints in a binary search tree which is also a max-heap on node priorities. The priority of a node is a hash
+ * of its value, so a set always has the same shape no matter in which order it was built, and the expected depth of
+ * every node is O(log n).
+ *
+ * Everything is built on two primitives: split cuts a treap at a key into the smaller and the bigger values, join
+ * concatenates two treaps whose values do not overlap. Union, intersection and difference split the second set at the
+ * root of the first and recurse into both halves independently, which takes O(m log(n / m + 1)) expected time for sets
+ * of size m <= n. The two recursive calls of the upper levels run in parallel threads for large sets.
+ *
+ * Set operations consume their inputs: the result replaces the first treap and the second one is left empty. Nodes are
+ * allocated with malloc since they are freed by several threads. Compile with -pthread.
+ */
+
+
+/// Subproblems below this amount of nodes are never handed to another thread
+#define TREAP_PARALLEL_CUTOFF 16384
+/// Levels of parallel recursion beyond log2(threads), since the halves of a split are rarely equally big
+#define TREAP_PARALLEL_EXTRA_DEPTH 2
+
+// DATA STRUCTURES
+
+typedef struct treap_node TreapNode;
+
+/// size is the amount of nodes in the subtree
+struct treap_node {
+    int value;
+    uint32_t priority;
+    size_t size;
+    TreapNode *left;
+    TreapNode *right;
+};
+
+typedef struct treap {
+    TreapNode *root;
+} Treap;
+
+typedef enum {TREAP_UNION, TREAP_INTERSECTION, TREAP_DIFFERENCE} TreapOperation;
+
+/// The arguments and the result of a set operation on two subtrees, so it can run in its own thread
+typedef struct treap_task {
+    TreapOperation operation;
+    TreapNode *a;
+    TreapNode *b;
+    size_t depth;
+    TreapNode *result;
+} TreapTask;
+
+// CONSTRUCTORS AND DESTRUCTORS
+
+/// Derives the priority of a value with the splitmix64 finalizer
+/// \param value The value
+/// \return A priority which looks random, but is the same for equal values
+uint32_t treap_priority(int value) {
+    uint64_t z = (uint64_t) (uint32_t) value + 0x9E3779B97F4A7C15ULL;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return (uint32_t) ((z ^ (z >> 31)) >> 32);
+}
+
+/// Creates a new treap node
+/// \param value The value of the new node
+/// \return A pointer to the new node or NULL in case of memory error
+TreapNode *treap_node_create(int value) {
+    TreapNode *result = malloc(sizeof(TreapNode));
+    if (result == NULL) {
+        perror("Could not allocate memory!");
+        return NULL;
+    }
+
+    result->value = value;
+    result->priority = treap_priority(value);
+    result->size = 1;
+    result->left = NULL;
+    result->right = NULL;
+    return result;
+}
+
+/// Destroys a node and all of its descendants without recursion by rotating left children up while walking down the
+/// chain of right children
+/// \param node The subtree to destroy
+/// \return A NULL pointer to clean up the node pointer
+TreapNode *treap_nodes_destroy(TreapNode *node) {
+    while (node) {
+        if (node->left) {
+            TreapNode *left = node->left;
+            node->left = left->right;
+            left->right = node;
+            node = left;
+        } else {
+            TreapNode *right = node->right;
+            free(node);
+            node = right;
+        }
+    }
+    return NULL;
+}
+
+/// Creates an empty treap
+/// \return A pointer to the treap or NULL in case of memory error
+Treap *treap_create() {
+    Treap *result = malloc(sizeof(Treap));
+    if (result == NULL) {
+        perror("Could not allocate memory!");
+        return NULL;
+    }
+
+    result->root = NULL;
+    return result;
+}
+
+/// Destroys the treap and all of its nodes
+/// \param treap The treap to destroy
+/// \return A NULL pointer to clean up the treap pointer
+Treap *treap_destroy(Treap *treap) {
+    if (treap) {
+        treap->root = treap_nodes_destroy(treap->root);
+    }
+    free(treap);
+    return NULL;
+}
+
+// FUNCTIONS
+
+/// Returns the amount of nodes in a subtree
+/// \param node The subtree, which may be NULL
+/// \return The size, 0 for an empty subtree
+size_t treap_node_size(const TreapNode *node) {
+    return node ? node->size : 0;
+}
+
+/// Recomputes the size of a node after its children changed
+/// \param node The node to update
+void treap_node_update(TreapNode *node) {
+    node->size = treap_node_size(node->left) + treap_node_size(node->right) + 1;
+}
+
+/// Returns the amount of values in the treap
+/// \param treap The treap
+/// \return The size
+size_t treap_size(const Treap *treap) {
+    return treap_node_size(treap->root);
+}
+
+/// Creates a treap from sorted values in O(n) by building the Cartesian tree of the priorities along the right spine
+/// \param values The values in ascending order, duplicates are skipped
+/// \param length The amount of values
+/// \return A pointer to the treap or NULL in case of memory error
+Treap *treap_create_from_sorted(const int *values, size_t length) {
+    Treap *result = treap_create();
+    TreapNode **spine = malloc((length ? length : 1) * sizeof(TreapNode *));
+    if (result == NULL || spine == NULL) {
+        free(spine);
+        return treap_destroy(result);
+    }
+
+    size_t spine_length = 0;
+    for (size_t i = 0; i < length; ++i) {
+        if (i > 0 && values[i] == values[i - 1]) {
+            continue;
+        }
+
+        TreapNode *node = treap_node_create(values[i]);
+        if (node == NULL) {
+            result->root = spine_length ? spine[0] : NULL;
+            free(spine);
+            return treap_destroy(result);
+        }
+
+        // Nodes with a lower priority become the left subtree of the new node. They are complete now
+        TreapNode *last = NULL;
+        while (spine_length && spine[spine_length - 1]->priority < node->priority) {
+            last = spine[--spine_length];
+            treap_node_update(last);
+        }
+        node->left = last;
+        if (spine_length) {
+            spine[spine_length - 1]->right = node;
+        }
+        spine[spine_length++] = node;
+    }
+
+    while (spine_length) {
+        treap_node_update(spine[--spine_length]);
+    }
+    result->root = length ? spine[0] : NULL;
+
+    free(spine);
+    return result;
+}
+
+/// Splits a subtree at a key
+/// \param node The subtree to split, it is dismantled
+/// \param key The key to split at
+/// \param left Receives the subtree of all values smaller than key
+/// \param right Receives the subtree of all values bigger than key
+/// \param equal Receives the detached node holding key or NULL if there is none
+void treap_split(TreapNode *node, int key, TreapNode **left, TreapNode **right, TreapNode **equal) {
+    if (node == NULL) {
+        *left = NULL;
+        *right = NULL;
+        *equal = NULL;
+    } else if (node->value < key) {
+        treap_split(node->right, key, &node->right, right, equal);
+        treap_node_update(node);
+        *left = node;
+    } else if (node->value > key) {
+        treap_split(node->left, key, left, &node->left, equal);
+        treap_node_update(node);
+        *right = node;
+    } else {
+        *left = node->left;
+        *right = node->right;
+        node->left = NULL;
+        node->right = NULL;
+        node->size = 1;
+        *equal = node;
+    }
+}
+
+/// Joins two subtrees where all values of left are smaller than all values of right
+/// \param left The subtree of the smaller values
+/// \param right The subtree of the bigger values
+/// \return The joined subtree
+TreapNode *treap_join(TreapNode *left, TreapNode *right) {
+    if (left == NULL) {
+        return right;
+    }
+    if (right == NULL) {
+        return left;
+    }
+
+    if (left->priority > right->priority) {
+        left->right = treap_join(left->right, right);
+        treap_node_update(left);
+        return left;
+    }
+    right->left = treap_join(left, right->left);
+    treap_node_update(right);
+    return right;
+}
+
+/// Checks whether the treap holds a value
+/// \param treap The treap to search in
+/// \param value The value to search
+/// \return 1 if the value was found, else 0
+int treap_contains(const Treap *treap, int value) {
+    const TreapNode *node = treap->root;
+    while (node && node->value != value) {
+        node = (value < node->value) ? node->left : node->right;
+    }
+    return node != NULL;
+}
+
+/// Adds a value to the treap unless it is already contained
+/// \param treap The treap to extend
+/// \param value The value to insert
+/// \return 0 if successful, else 1 in case of memory error
+int treap_add(Treap *treap, int value) {
+    TreapNode *left, *right, *equal;
+    treap_split(treap->root, value, &left, &right, &equal);
+
+    if (equal == NULL) {
+        equal = treap_node_create(value);
+        if (equal == NULL) {
+            treap->root = treap_join(left, right);
+            return 1;
+        }
+    }
+
+    treap->root = treap_join(treap_join(left, equal), right);
+    return 0;
+}
+
+/// Removes a value from the treap
+/// \param treap The treap to remove from
+/// \param value The value to remove
+/// \return 0 if the value was removed, else 1 if it was not contained
+int treap_remove(Treap *treap, int value) {
+    TreapNode *left, *right, *equal;
+    treap_split(treap->root, value, &left, &right, &equal);
+    treap->root = treap_join(left, right);
+
+    if (equal == NULL) {
+        return 1;
+    }
+    free(equal);
+    return 0;
+}
+
+/// Copies the values of a subtree in ascending order into an array. The recursion is as deep as the subtree
+/// \param node The subtree to copy
+/// \param array The array to copy to
+/// \return The amount of copied values
+size_t treap_nodes_as_array(const TreapNode *node, int *array) {
+    size_t count = 0;
+    while (node) {
+        count += treap_nodes_as_array(node->left, array + count);
+        array[count++] = node->value;
+        node = node->right;
+    }
+    return count;
+}
+
+/// Copies the values of the treap in ascending order into an array
+/// \param treap The treap to copy
+/// \param array An array with space for treap_size(treap) values
+void treap_as_array(const Treap *treap, int *array) {
+    treap_nodes_as_array(treap->root, array);
+}
+
+TreapNode *treap_combine(TreapOperation operation, TreapNode *a, TreapNode *b, size_t depth) ;
+
+void *treap_task_run(void *argument) {
+    TreapTask *task = argument;
+    task->result = treap_combine(task->operation, task->a, task->b, task->depth);
+    return NULL;
+}
+
+/// Applies a set operation to the two halves of a split. The left half runs in a new thread if depth allows it and the
+/// halves are big enough, otherwise both run in the calling thread
+/// \param task The left half, its result is stored in the task
+/// \param right_a The right half of the first set
+/// \param right_b The right half of the second set
+/// \return The result of the right half
+TreapNode *treap_combine_halves(TreapTask *task, TreapNode *right_a, TreapNode *right_b) {
+    pthread_t thread;
+    int parallel = task->depth > 0
+                   && treap_node_size(task->a) + treap_node_size(task->b) >= TREAP_PARALLEL_CUTOFF
+                   && pthread_create(&thread, NULL, treap_task_run, task) == 0;
+
+    if (!parallel) {
+        treap_task_run(task);
+    }
+    TreapNode *result = treap_combine(task->operation, right_a, right_b, task->depth);
+    if (parallel) {
+        pthread_join(thread, NULL);
+    }
+    return result;
+}
+
+/// Applies a set operation to two subtrees, consuming both
+/// \param operation The set operation
+/// \param a The subtree of the first set
+/// \param b The subtree of the second set
+/// \param depth The amount of recursion levels which may still start new threads
+/// \return The resulting subtree
+TreapNode *treap_combine(TreapOperation operation, TreapNode *a, TreapNode *b, size_t depth) {
+    if (a == NULL || b == NULL) {
+        if (operation == TREAP_UNION) {
+            return a ? a : b;
+        }
+        treap_nodes_destroy(b);
+        return operation == TREAP_DIFFERENCE ? a : treap_nodes_destroy(a);
+    }
+
+    // Union and intersection are symmetric, so the root with the higher priority stays on top
+    if (operation != TREAP_DIFFERENCE && a->priority < b->priority) {
+        TreapNode *swap = a;
+        a = b;
+        b = swap;
+    }
+
+    TreapNode *right_b, *equal;
+    TreapTask task = {operation, a->left, NULL, depth ? depth - 1 : 0, NULL};
+    treap_split(b, a->value, &task.b, &right_b, &equal);
+
+    TreapNode *right = treap_combine_halves(&task, a->right, right_b);
+    TreapNode *left = task.result;
+
+    int keep = operation == TREAP_UNION
+               || (operation == TREAP_INTERSECTION && equal)
+               || (operation == TREAP_DIFFERENCE && !equal);
+    free(equal);
+
+    if (!keep) {
+        free(a);
+        return treap_join(left, right);
+    }
+    a->left = left;
+    a->right = right;
+    treap_node_update(a);
+    return a;
+}
+
+/// Applies a set operation to two treaps, using up to about threads threads for large sets
+/// \param operation The set operation
+/// \param a The first set, receives the result
+/// \param b The second set, is left empty
+/// \param threads The amount of threads to use, 1 to stay in the calling thread
+void treap_apply(TreapOperation operation, Treap *a, Treap *b, size_t threads) {
+    size_t depth = 0;
+    while (threads > ((size_t) 1 << depth)) {
+        ++depth;
+    }
+    if (depth) {
+        depth += TREAP_PARALLEL_EXTRA_DEPTH;
+    }
+
+    a->root = treap_combine(operation, a->root, b->root, depth);
+    b->root = NULL;
+}
+
+/// Stores the union of a and b in a and leaves b empty
+/// \param a The first set
+/// \param b The second set
+/// \param threads The amount of threads to use
+void treap_union(Treap *a, Treap *b, size_t threads) {
+    treap_apply(TREAP_UNION, a, b, threads);
+}
+
+/// Stores the intersection of a and b in a and leaves b empty
+/// \param a The first set
+/// \param b The second set
+/// \param threads The amount of threads to use
+void treap_intersection(Treap *a, Treap *b, size_t threads) {
+    treap_apply(TREAP_INTERSECTION, a, b, threads);
+}
+
+/// Stores all values of a which are not in b in a and leaves b empty
+/// \param a The first set
+/// \param b The second set
+/// \param threads The amount of threads to use
+void treap_difference(Treap *a, Treap *b, size_t threads) {
+    treap_apply(TREAP_DIFFERENCE, a, b, threads);
+}
+
+#endif